@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <XMLParserCPP.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+/*
+ * Parsing speed benchmark. Usage:
+ *
+ * xmlparsercpp_benchmark [-n iterations] file1.fb2 file2.xhtml ...
+ *
+ * Every file is parsed by parseDocument(), parseDocumentView() and
+ * parseDocumentStream(). Throughput is reported in MB/s of source size.
+ */
+
+double
+measure(const std::string &content, const int &iterations,
+        std::function<void(const std::string &)> func)
+{
+  func(content);
+  std::chrono::time_point<std::chrono::steady_clock> start
+      = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; i++)
+    {
+      func(content);
+    }
+  std::chrono::duration<double> dur
+      = std::chrono::steady_clock::now() - start;
+
+  return static_cast<double>(content.size()) * iterations / dur.count()
+         / 1048576.0;
+}
+
+int
+main(int argc, char *argv[])
+{
+  int iterations = 10;
+  std::vector<std::string> files;
+  for(int i = 1; i < argc; i++)
+    {
+      std::string arg(argv[i]);
+      if(arg == "-n" && i + 1 < argc)
+        {
+          i++;
+          iterations = std::stoi(argv[i]);
+        }
+      else
+        {
+          files.push_back(arg);
+        }
+    }
+  if(files.size() == 0 || iterations <= 0)
+    {
+      std::cout << "Usage: xmlparsercpp_benchmark [-n iterations] file..."
+                << std::endl;
+      return 1;
+    }
+
+  XMLParserCPP parser;
+  for(auto it = files.begin(); it != files.end(); it++)
+    {
+      std::fstream f;
+      f.open(*it, std::ios_base::in | std::ios_base::binary);
+      if(!f.is_open())
+        {
+          std::cout << *it << ": cannot open file" << std::endl;
+          continue;
+        }
+      std::stringstream strm;
+      strm << f.rdbuf();
+      f.close();
+      std::string content = strm.str();
+
+      try
+        {
+          double dom = measure(content, iterations,
+                               [&parser](const std::string &content)
+                                 {
+                                   parser.parseDocument(content);
+                                 });
+          double view = measure(content, iterations,
+                                [&parser](const std::string &content)
+                                  {
+                                    parser.parseDocumentView(content);
+                                  });
+          double stream
+              = measure(content, iterations,
+                        [&parser](const std::string &content)
+                          {
+                            parser.parseDocumentStream(
+                                content,
+                                [](XMLStreamEvent &)
+                                  {
+                                    return true;
+                                  });
+                          });
+          std::cout << *it << " (" << content.size() << " bytes): "
+                    << "parseDocument " << dom << " MB/s, "
+                    << "parseDocumentView " << view << " MB/s, "
+                    << "parseDocumentStream " << stream << " MB/s"
+                    << std::endl;
+        }
+      catch(std::exception &er)
+        {
+          std::cout << *it << ": " << er.what() << std::endl;
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef XMLDOCUMENT_H
+#define XMLDOCUMENT_H
+
+#include <XMLNode.h>
+#include <deque>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*!
+ * \brief The XMLDocument class
+ *
+ * Result of XMLParserCPP::parseDocumentView(). This class keeps document
+ * buffer in UTF-8 and all nodes. Nodes and attributes are allocated from
+ * per-document arena, their names, content and attribute values are views
+ * to document buffer (only strings containing XML entities are stored
+ * separately). All nodes are freed together with XMLDocument.
+ */
+class XMLDocument
+{
+public:
+  /*!
+   * \brief XMLDocument constructor.
+   */
+  XMLDocument();
+
+  XMLDocument(const XMLDocument &other) = delete;
+
+  /*!
+   * \brief XMLDocument move constructor.
+   * \param other XMLDocument to be moved.
+   */
+  XMLDocument(XMLDocument &&other);
+
+  XMLDocument &
+  operator=(const XMLDocument &other)
+      = delete;
+
+  /*!
+   * \brief operator =
+   * \param other XMLDocument to be moved.
+   * \return Reference to this XMLDocument.
+   */
+  XMLDocument &
+  operator=(XMLDocument &&other);
+
+  virtual ~XMLDocument();
+
+  /*!
+   * \brief Returns first top level node.
+   * \return Pointer to node or nullptr if document is empty.
+   */
+  const XMLNode *
+  firstNode() const;
+
+  /*!
+   * \brief Searches nodes recursively in whole document.
+   * \param name Name of nodes to be found.
+   * \param result Vector found nodes will be added to.
+   */
+  void
+  searchNode(const std::string_view &name,
+             std::vector<const XMLNode *> &result) const;
+
+private:
+  friend class XMLParserCPP;
+
+  template <class T>
+  T *
+  allocate()
+  {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "XMLDocument::allocate: type should be trivially "
+                  "destructible");
+    size_t pos = (block_position + alignof(T) - 1) & ~(alignof(T) - 1);
+    if(blocks.size() == 0 || pos + sizeof(T) > block_size)
+      {
+        blocks.emplace_back(new char[block_size]);
+        pos = 0;
+      }
+    block_position = pos + sizeof(T);
+    return new(blocks.rbegin()->get() + pos) T();
+  }
+
+  std::string_view
+  storeString(std::string &&str);
+
+  std::unique_ptr<std::string> buffer;
+
+  std::deque<std::string> strings;
+
+  std::vector<std::unique_ptr<char[]>> blocks;
+
+  size_t block_size = 32768;
+
+  size_t block_position = 0;
+
+  XMLNode *first_node = nullptr;
+};
+
+#endif // XMLDOCUMENT_H
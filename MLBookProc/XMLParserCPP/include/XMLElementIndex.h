@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef XMLELEMENTINDEX_H
+#define XMLELEMENTINDEX_H
+
+#include <XMLElement.h>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * \brief The XMLElementIndex class
+ *
+ * Optional index of XML elements by their names. Index is built by one pass
+ * over elements obtained from XMLParserCPP::parseDocument(). After that every
+ * search by element name is a hash table lookup instead of recursive walk
+ * over all elements (as in XMLAlgorithms). Search in subelements of
+ * particular elements is supported as well: elements are numbered in document
+ * order, so subelements of any element occupy continuous range of numbers.
+ *
+ * \warning Index keeps pointers to indexed elements. It becomes invalid if any
+ * changes are made to the source elements vector.
+ */
+class XMLElementIndex
+{
+public:
+  /*!
+   * \brief XMLElementIndex constructor.
+   *
+   * Creates empty index (see build()).
+   */
+  XMLElementIndex();
+
+  /*!
+   * \brief XMLElementIndex constructor.
+   *
+   * Creates index of \a elements (see build()).
+   * \param elements Vector of XMLElement to be indexed.
+   */
+  XMLElementIndex(const std::vector<XMLElement> &elements);
+
+  /*!
+   * \brief Builds index.
+   *
+   * Previous index content will be discarded.
+   * \param elements Vector of XMLElement to be indexed (including all
+   * subelements).
+   */
+  void
+  build(const std::vector<XMLElement> &elements);
+
+  /*!
+   * \brief Clears index.
+   */
+  void
+  clear();
+
+  /*!
+   * \brief Searches for XML elements.
+   *
+   * Analogue of XMLAlgorithms::searchElement() for all indexed elements.
+   * \param element_name Desired XML element name.
+   * \param result Vector of pointers to XMLElement search results to be
+   * appended to (in document order).
+   */
+  void
+  searchElement(const std::string &element_name,
+                std::vector<XMLElement *> &result) const;
+
+  /*!
+   * \brief Searches for XML elements.
+   *
+   * Analogue of XMLAlgorithms::searchElement() for all indexed elements.
+   * \param element_name Desired XML element name.
+   * \param attribute_id Desired XML element attribute name.
+   * \param attribute_value Desired attribute value (if empty, only attribute
+   * presence is checked).
+   * \param result Vector of pointers to XMLElement search results to be
+   * appended to (in document order).
+   */
+  void
+  searchElement(const std::string &element_name,
+                const std::string &attribute_id,
+                const std::string &attribute_value,
+                std::vector<XMLElement *> &result) const;
+
+  /*!
+   * \brief Searches for XML elements.
+   *
+   * Analogue of XMLAlgorithms::searchElement() for vector of pointers to
+   * XMLElement. Elements from \a elements are included to search as well as
+   * their subelements. If some of \a elements have not been indexed, search
+   * for them is carried out by XMLAlgorithms::searchElement().
+   * \param elements Vector of pointers to XMLElement search to be carried
+   * out on.
+   * \param element_name Desired XML element name.
+   * \param result Vector of pointers to XMLElement search results to be
+   * appended to.
+   */
+  void
+  searchElement(const std::vector<XMLElement *> &elements,
+                const std::string &element_name,
+                std::vector<XMLElement *> &result) const;
+
+  /*!
+   * \brief Searches for XML elements.
+   *
+   * Same as previous method, but only elements containing attribute \a
+   * attribute_id are included to result.
+   * \param elements Vector of pointers to XMLElement search to be carried
+   * out on.
+   * \param element_name Desired XML element name.
+   * \param attribute_id Desired XML element attribute name.
+   * \param attribute_value Desired attribute value (if empty, only attribute
+   * presence is checked).
+   * \param result Vector of pointers to XMLElement search results to be
+   * appended to.
+   */
+  void
+  searchElement(const std::vector<XMLElement *> &elements,
+                const std::string &element_name,
+                const std::string &attribute_id,
+                const std::string &attribute_value,
+                std::vector<XMLElement *> &result) const;
+
+private:
+  void
+  buildRecursive(const std::vector<XMLElement> &elements, size_t &position);
+
+  bool
+  checkAttribute(const XMLElement *element, const std::string &attribute_id,
+                 const std::string &attribute_value) const;
+
+  std::unordered_map<std::string,
+                     std::vector<std::tuple<size_t, XMLElement *>>>
+      names;
+
+  std::unordered_map<const XMLElement *, std::tuple<size_t, size_t>> ranges;
+};
+
+#endif // XMLELEMENTINDEX_H
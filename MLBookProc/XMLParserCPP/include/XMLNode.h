@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef XMLNODE_H
+#define XMLNODE_H
+
+#include <XMLElement.h>
+#include <XMLNodeAttribute.h>
+#include <string_view>
+#include <vector>
+
+/*!
+ * \brief The XMLNode class
+ *
+ * Node of XMLDocument. Unlike XMLElement, this class does not own any
+ * strings: names, content and attribute values are views to XMLDocument
+ * buffer. Subnodes form singly linked list.
+ *
+ * \warning XMLNode objects are owned by XMLDocument and are valid while
+ * XMLDocument exists.
+ */
+class XMLNode
+{
+public:
+  /*!
+   * \brief Searches attribute by its name.
+   * \param attribute_id Attribute name.
+   * \return Pointer to attribute or nullptr if nothing has been found.
+   */
+  const XMLNodeAttribute *
+  attribute(const std::string_view &attribute_id) const;
+
+  /*!
+   * \brief Returns content of first XMLElement::ElementContent subnode.
+   * \return Content or empty string_view if node has no content.
+   */
+  std::string_view
+  text() const;
+
+  /*!
+   * \brief Searches nodes recursively (this node is not included).
+   * \param name Name of nodes to be found.
+   * \param result Vector found nodes will be added to.
+   */
+  void
+  searchNode(const std::string_view &name,
+             std::vector<const XMLNode *> &result) const;
+
+  /*!
+   * \brief Searches nodes of given type recursively (this node is not
+   * included).
+   * \param node_type Type of nodes to be found.
+   * \param result Vector found nodes will be added to.
+   */
+  void
+  searchNode(const XMLElement::Type &node_type,
+             std::vector<const XMLNode *> &result) const;
+
+  /*!
+   * \brief Node name (empty for XMLElement::ElementContent and special nodes).
+   */
+  std::string_view node_name;
+
+  /*!
+   * \brief Node content if any (XML entities are replaced except for CDATA).
+   */
+  std::string_view content;
+
+  /*!
+   * \brief Node type.
+   */
+  XMLElement::Type node_type = XMLElement::OrdinaryElement;
+
+  /*!
+   * \brief Node emptiness indicator.
+   */
+  XMLElement::Empty empty = XMLElement::NotEmpty;
+
+  /*!
+   * \brief First attribute (nullptr if node has no attributes).
+   */
+  XMLNodeAttribute *first_attribute = nullptr;
+
+  /*!
+   * \brief Parent node (nullptr for top level nodes).
+   */
+  XMLNode *parent = nullptr;
+
+  /*!
+   * \brief First subnode (nullptr if node has no subnodes).
+   */
+  XMLNode *first_child = nullptr;
+
+  /*!
+   * \brief Next node of the same level (nullptr if node is last one).
+   */
+  XMLNode *next_sibling = nullptr;
+};
+
+#endif // XMLNODE_H
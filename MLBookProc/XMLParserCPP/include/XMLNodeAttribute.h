@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef XMLNODEATTRIBUTE_H
+#define XMLNODEATTRIBUTE_H
+
+#include <string_view>
+
+/*!
+ * \brief The XMLNodeAttribute class
+ *
+ * This class contains XMLNode attribute. Attributes of node form singly
+ * linked list.
+ *
+ * \warning XMLNodeAttribute objects are owned by XMLDocument and are valid
+ * while XMLDocument exists.
+ */
+class XMLNodeAttribute
+{
+public:
+  /*!
+   * \brief Attribute name.
+   */
+  std::string_view attribute_id;
+
+  /*!
+   * \brief Attribute value (XML entities are replaced).
+   */
+  std::string_view attribute_value;
+
+  /*!
+   * \brief Next attribute of the same node (nullptr if this attribute is
+   * last one).
+   */
+  XMLNodeAttribute *next = nullptr;
+};
+
+#endif // XMLNODEATTRIBUTE_H
@@ -16,8 +16,14 @@
 #ifndef XMLPARSERCPP_H
 #define XMLPARSERCPP_H
 
+#include <XMLDocument.h>
 #include <XMLElement.h>
+#include <XMLStreamEvent.h>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 /*!
@@ -34,7 +40,7 @@
  * endif()
  * \endcode
  *
- * Further reading: XMLParserCPP, XMLAlgorithms.
+ * Further reading: XMLParserCPP, XMLAlgorithms, XMLElementIndex.
  */
 
 /*!
@@ -63,13 +69,72 @@ public:
   std::vector<XMLElement>
   parseDocument(const std::string &xml_document);
 
+  /*!
+   * \brief Parses XML document without building elements tree.
+   *
+   * This method reports start and end of elements, their attributes and
+   * content to \a callback in document order. No elements are stored, so
+   * memory consumption does not depend on document size (except for
+   * conversion to UTF-8, which is skipped if document is already in UTF-8).
+   * XML entities are replaced in content and attribute values (CDATA content
+   * is passed as is). Parsing is stopped as soon as \a callback returns \a
+   * false.
+   *
+   * \note This method can throw std::exception in case of any errors.
+   *
+   * \param xml_document XML document content.
+   * \param callback Function to be called for each event. XMLStreamEvent
+   * object is reused between calls, so its fields should be copied (or
+   * moved) if they are needed after callback returns.
+   * \return \a false if parsing has been stopped by \a callback, otherwise
+   * \a true.
+   */
+  bool
+  parseDocumentStream(const std::string &xml_document,
+                      std::function<bool(XMLStreamEvent &event)> callback);
+
+  /*!
+   * \brief Parses XML document to XMLDocument.
+   *
+   * Unlike parseDocument(), this method does not copy names, content and
+   * attribute values: XMLNode objects refer to document buffer kept by
+   * XMLDocument. Nodes are allocated from XMLDocument arena. Pass \a
+   * xml_document by std::move to avoid copying if document is already in
+   * UTF-8.
+   *
+   * \note This method can throw std::exception in case of any errors.
+   *
+   * \param xml_document XML document content.
+   * \return XMLDocument object.
+   */
+  XMLDocument
+  parseDocumentView(std::string xml_document);
+
 private:
+  std::string
+  documentCodePage(const std::string &xml_document);
+
+  void
+  parseSpecialView(XMLDocument &doc, size_t &position, XMLNode *node);
+
+  XMLNodeAttribute *
+  parseAttributesView(XMLDocument &doc, size_t &position, bool &empty);
+
+  std::string_view
+  viewOrDecode(XMLDocument &doc, const size_t &start, const size_t &end);
+
   void
   replaceXMLEntities(std::vector<XMLElement> &elements);
 
   void
   replacementFunc(std::string &str);
 
+  void
+  decodeEntities(std::string_view source, std::string &result);
+
+  bool
+  appendUTF8(const uint32_t &ch, std::string &result);
+
   XMLElement
   parseTag(const std::string &document, size_t &position);
 
@@ -84,8 +149,6 @@ private:
   formResult(std::vector<XMLElement> &result,
              std::vector<XMLElement>::iterator start,
              std::vector<XMLElement>::iterator end);
-
-  std::vector<std::tuple<std::string, std::string>> replacement;
 };
 
 #endif // XMLPARSERCPP_H
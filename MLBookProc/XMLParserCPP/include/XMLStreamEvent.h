@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef XMLSTREAMEVENT_H
+#define XMLSTREAMEVENT_H
+
+#include <XMLElementAttribute.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief The XMLStreamEvent class
+ *
+ * This class contains parameters of event passed to callback by
+ * XMLParserCPP::parseDocumentStream().
+ */
+class XMLStreamEvent
+{
+public:
+  /*!
+   * \brief XMLStreamEvent constructor.
+   */
+  XMLStreamEvent();
+
+  /*!
+   * \brief Clears all event parameters.
+   */
+  void
+  clear();
+
+  /*!
+   * \brief Event types enumerator.
+   */
+  enum Type
+  {
+    /*! Element start \code{.unparsed}<element>\endcode. Empty elements
+     * \code{.unparsed}<element />\endcode produce StartElement and
+     * EndElement events.*/
+    StartElement,
+    /*! Element end \code{.unparsed}</element>\endcode*/
+    EndElement,
+    /*! Element content (only content containing not space symbols is
+       reported)*/
+    Content,
+    /*! Char data elements \code{.unparsed}<![CDATA[]]>\endcode*/
+    CharData,
+    /*! XML comments \code{.unparsed}<!-- Comment -->\endcode*/
+    Comment,
+    /*! Special XML elements like \code{.unparsed}<!DOCTYPE html>\endcode*/
+    SpecialElement,
+    /*! \"Header\" XML elements like
+     * \code{.unparsed}<?xml version="1.0" encoding="UTF-8"?>\endcode
+     */
+    ProgramControlElement
+  };
+
+  /*!
+   * \brief Event type.
+   */
+  Type event_type = Type::StartElement;
+
+  /*!
+   * \brief XML element name (StartElement, EndElement and
+   * ProgramControlElement events only).
+   */
+  std::string element_name;
+
+  /*!
+   * \brief Vector of XML element attributes (StartElement and
+   * ProgramControlElement events only).
+   */
+  std::vector<XMLElementAttribute> element_attributes;
+
+  /*!
+   * \brief Content (Content, CharData, Comment and SpecialElement events
+   * only).
+   */
+  std::string content;
+
+  /*!
+   * \brief Nesting level of element or content. Root element has depth 0,
+   * its subelements and content have depth 1 and so on.
+   */
+  size_t depth = 0;
+};
+
+#endif // XMLSTREAMEVENT_H
@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+typedef struct UConverter UConverter;
+
 /*!
  * \brief The XMLTextEncoding class
  *
@@ -32,15 +34,36 @@ public:
   /*!
    * \brief Detects XML document encoding.
    *
-   * This method tries to detect encoding from the XML header. If operation was
-   * not successfull, tries to detect encoding by <A
+   * This method tries to detect encoding from byte order mark and then from
+   * the XML header. If operation was not successfull, document is checked to
+   * be valid UTF-8. If it is not, method tries to detect encoding by <A
    * HREF="https://unicode-org.github.io/icu-docs/apidoc/released/icu4c/ucsdet_8h.html">ICU
-   * library</A> methods.
+   * library</A> methods on first \a sniff_limit bytes of document.
    * \param document String, containing XML document.
+   * \param sniff_limit Maximum number of bytes to be passed to ICU detector.
    * \return Text code page. Empty in case of any errors.
    */
   static std::string
-  detectDocumentEncoding(const std::string &document);
+  detectDocumentEncoding(const std::string &document,
+                         const size_t &sniff_limit = size_t(65536));
+
+  /*!
+   * \brief Detects encoding by byte order mark.
+   * \param str String to be checked.
+   * \return Code page or empty string if \a str does not start with byte
+   * order mark.
+   */
+  static std::string
+  detectBOMEncoding(const std::string &str);
+
+  /*!
+   * \brief Checks if string is valid UTF-8.
+   * \param str String to be checked.
+   * \return \a true if \a str is valid UTF-8 (ASCII strings are valid UTF-8
+   * too).
+   */
+  static bool
+  isValidUTF8(const std::string &str);
 
   /*!
    * \brief Detects text string encoding.
@@ -57,6 +80,11 @@ public:
 
   /*!
    * \brief Converts string from one encoding to another.
+   *
+   * Converters are cached per thread, so repeated conversions do not open
+   * them again. Conversion is skipped if both code pages are UTF-8 and \a
+   * source is valid UTF-8.
+   *
    * \param source String to be converted.
    * \param result Result of conversion (emty in case of any errors).
    * \param source_code_page Code page of \b source string (if empty, default
@@ -68,6 +96,13 @@ public:
   convertToEncoding(const std::string &source, std::string &result,
                     const std::string &source_code_page,
                     const std::string &result_code_page);
+
+private:
+  static std::string
+  declaredEncoding(const std::string &document);
+
+  static UConverter *
+  converter(const std::string &code_page);
 };
 
 #endif // XMLTEXTENCODING_H
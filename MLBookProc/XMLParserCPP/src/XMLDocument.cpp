@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <XMLDocument.h>
+
+XMLDocument::XMLDocument()
+{
+}
+
+XMLDocument::XMLDocument(XMLDocument &&other)
+{
+  buffer = std::move(other.buffer);
+  strings = std::move(other.strings);
+  blocks = std::move(other.blocks);
+  block_position = other.block_position;
+  first_node = other.first_node;
+  other.block_position = 0;
+  other.first_node = nullptr;
+}
+
+XMLDocument &
+XMLDocument::operator=(XMLDocument &&other)
+{
+  if(this != &other)
+    {
+      buffer = std::move(other.buffer);
+      strings = std::move(other.strings);
+      blocks = std::move(other.blocks);
+      block_position = other.block_position;
+      first_node = other.first_node;
+      other.block_position = 0;
+      other.first_node = nullptr;
+    }
+  return *this;
+}
+
+XMLDocument::~XMLDocument()
+{
+}
+
+const XMLNode *
+XMLDocument::firstNode() const
+{
+  return first_node;
+}
+
+void
+XMLDocument::searchNode(const std::string_view &name,
+                        std::vector<const XMLNode *> &result) const
+{
+  for(const XMLNode *node = first_node; node != nullptr;
+      node = node->next_sibling)
+    {
+      if(node->node_name == name)
+        {
+          result.push_back(node);
+        }
+      node->searchNode(name, result);
+    }
+}
+
+std::string_view
+XMLDocument::storeString(std::string &&str)
+{
+  strings.emplace_back(std::move(str));
+  return std::string_view(*strings.rbegin());
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <XMLAlgorithms.h>
+#include <XMLElementIndex.h>
+#include <algorithm>
+
+XMLElementIndex::XMLElementIndex()
+{
+}
+
+XMLElementIndex::XMLElementIndex(const std::vector<XMLElement> &elements)
+{
+  build(elements);
+}
+
+void
+XMLElementIndex::build(const std::vector<XMLElement> &elements)
+{
+  clear();
+  size_t position = 0;
+  buildRecursive(elements, position);
+}
+
+void
+XMLElementIndex::clear()
+{
+  names.clear();
+  ranges.clear();
+}
+
+void
+XMLElementIndex::searchElement(const std::string &element_name,
+                               std::vector<XMLElement *> &result) const
+{
+  auto it = names.find(element_name);
+  if(it != names.end())
+    {
+      result.reserve(result.size() + it->second.size());
+      for(auto it_el = it->second.begin(); it_el != it->second.end(); it_el++)
+        {
+          result.push_back(std::get<1>(*it_el));
+        }
+    }
+}
+
+void
+XMLElementIndex::searchElement(const std::string &element_name,
+                               const std::string &attribute_id,
+                               const std::string &attribute_value,
+                               std::vector<XMLElement *> &result) const
+{
+  auto it = names.find(element_name);
+  if(it != names.end())
+    {
+      for(auto it_el = it->second.begin(); it_el != it->second.end(); it_el++)
+        {
+          if(checkAttribute(std::get<1>(*it_el), attribute_id,
+                            attribute_value))
+            {
+              result.push_back(std::get<1>(*it_el));
+            }
+        }
+    }
+}
+
+void
+XMLElementIndex::searchElement(const std::vector<XMLElement *> &elements,
+                               const std::string &element_name,
+                               std::vector<XMLElement *> &result) const
+{
+  searchElement(elements, element_name, std::string(), std::string(),
+                result);
+}
+
+void
+XMLElementIndex::searchElement(const std::vector<XMLElement *> &elements,
+                               const std::string &element_name,
+                               const std::string &attribute_id,
+                               const std::string &attribute_value,
+                               std::vector<XMLElement *> &result) const
+{
+  auto it = names.find(element_name);
+  for(auto it_el = elements.begin(); it_el != elements.end(); it_el++)
+    {
+      auto it_r = ranges.find(*it_el);
+      if(it_r == ranges.end())
+        {
+          std::vector<XMLElement *> el = {*it_el};
+          if(attribute_id.empty())
+            {
+              XMLAlgorithms::searchElement(el, element_name, result);
+            }
+          else if(attribute_value.empty())
+            {
+              XMLAlgorithms::searchElement(el, element_name, attribute_id,
+                                           result);
+            }
+          else
+            {
+              XMLAlgorithms::searchElement(el, element_name, attribute_id,
+                                           attribute_value, result);
+            }
+          continue;
+        }
+      if(it == names.end())
+        {
+          continue;
+        }
+
+      size_t begin = std::get<0>(it_r->second);
+      size_t end = std::get<1>(it_r->second);
+      auto it_found = std::lower_bound(
+          it->second.begin(), it->second.end(), begin,
+          [](const std::tuple<size_t, XMLElement *> &el, const size_t &val)
+            {
+              return std::get<0>(el) < val;
+            });
+      for(; it_found != it->second.end(); it_found++)
+        {
+          if(std::get<0>(*it_found) >= end)
+            {
+              break;
+            }
+          if(attribute_id.empty()
+             || checkAttribute(std::get<1>(*it_found), attribute_id,
+                               attribute_value))
+            {
+              result.push_back(std::get<1>(*it_found));
+            }
+        }
+    }
+}
+
+void
+XMLElementIndex::buildRecursive(const std::vector<XMLElement> &elements,
+                                size_t &position)
+{
+  XMLElement *end
+      = const_cast<XMLElement *>(elements.data() + elements.size());
+  for(XMLElement *it_el = const_cast<XMLElement *>(elements.data());
+      it_el != end; it_el++)
+    {
+      size_t begin = position;
+      position++;
+      names[it_el->element_name].emplace_back(std::make_tuple(begin, it_el));
+      buildRecursive(it_el->elements, position);
+      ranges.emplace(it_el, std::make_tuple(begin, position));
+    }
+}
+
+bool
+XMLElementIndex::checkAttribute(const XMLElement *element,
+                                const std::string &attribute_id,
+                                const std::string &attribute_value) const
+{
+  auto it = std::find_if(element->element_attributes.begin(),
+                         element->element_attributes.end(),
+                         [&attribute_id](const XMLElementAttribute &el)
+                           {
+                             return el.attribute_id == attribute_id;
+                           });
+  if(it == element->element_attributes.end())
+    {
+      return false;
+    }
+
+  return attribute_value.empty() || it->attribute_value == attribute_value;
+}
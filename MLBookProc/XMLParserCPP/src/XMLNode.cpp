@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <XMLNode.h>
+
+const XMLNodeAttribute *
+XMLNode::attribute(const std::string_view &attribute_id) const
+{
+  for(const XMLNodeAttribute *attr = first_attribute; attr != nullptr;
+      attr = attr->next)
+    {
+      if(attr->attribute_id == attribute_id)
+        {
+          return attr;
+        }
+    }
+  return nullptr;
+}
+
+std::string_view
+XMLNode::text() const
+{
+  for(const XMLNode *node = first_child; node != nullptr;
+      node = node->next_sibling)
+    {
+      if(node->node_type == XMLElement::ElementContent)
+        {
+          return node->content;
+        }
+    }
+  return std::string_view();
+}
+
+void
+XMLNode::searchNode(const std::string_view &name,
+                    std::vector<const XMLNode *> &result) const
+{
+  for(const XMLNode *node = first_child; node != nullptr;
+      node = node->next_sibling)
+    {
+      if(node->node_name == name)
+        {
+          result.push_back(node);
+        }
+      node->searchNode(name, result);
+    }
+}
+
+void
+XMLNode::searchNode(const XMLElement::Type &node_type,
+                    std::vector<const XMLNode *> &result) const
+{
+  for(const XMLNode *node = first_child; node != nullptr;
+      node = node->next_sibling)
+    {
+      if(node->node_type == node_type)
+        {
+          result.push_back(node);
+        }
+      node->searchNode(node_type, result);
+    }
+}
@@ -16,17 +16,13 @@
 #include <XMLParserCPP.h>
 #include <XMLTextEncoding.h>
 #include <algorithm>
-#include <sstream>
-#include <unicode/unistr.h>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
 
 XMLParserCPP::XMLParserCPP()
 {
-  replacement.reserve(5);
-  replacement.push_back(std::make_tuple("amp", "&"));
-  replacement.push_back(std::make_tuple("apos", "'"));
-  replacement.push_back(std::make_tuple("gt", ">"));
-  replacement.push_back(std::make_tuple("lt", "<"));
-  replacement.push_back(std::make_tuple("quot", "\""));
 }
 
 std::vector<XMLElement>
@@ -38,30 +34,20 @@ XMLParserCPP::parseDocument(const std::string &xml_document)
       return result;
     }
 
-  std::string code_page;
-  {
-    std::vector<std::string> cp
-        = XMLTextEncoding::detectStringEncoding(xml_document, true);
-    if(cp.size() > 0)
-      {
-        code_page = cp[0];
-      }
-    else
-      {
-        throw std::runtime_error(
-            "XMLParserCPP::parseDocument: cannot determine document encoding");
-      }
-  }
-
-  std::string document;
-  XMLTextEncoding::convertToEncoding(xml_document, document, code_page,
-                                     "UTF-8");
+  std::string code_page = documentCodePage(xml_document);
 
-  if(document.empty())
+  std::string converted;
+  if(code_page != "UTF-8")
     {
-      throw std::runtime_error(
-          "XMLParserCPP::parseDocument: error on conversion to UTF-8");
+      XMLTextEncoding::convertToEncoding(xml_document, converted, code_page,
+                                         "UTF-8");
+      if(converted.empty())
+        {
+          throw std::runtime_error(
+              "XMLParserCPP::parseDocument: error on conversion to UTF-8");
+        }
     }
+  const std::string &document = converted.empty() ? xml_document : converted;
 
   std::string find_str("<");
   std::string::size_type n = document.find(find_str);
@@ -73,49 +59,605 @@ XMLParserCPP::parseDocument(const std::string &xml_document)
 
   std::vector<XMLElement> elements;
 
+  // Text runs are found by std::string::find (memchr, which is vectorized in
+  // common C libraries) and copied in bulk.
   size_t limit = document.size();
-  XMLElement content;
-  content.element_type = XMLElement::ElementContent;
+  for(size_t i = n; i < limit; i++)
+    {
+      std::string::size_type n2 = document.find('<', i);
+      if(n2 == std::string::npos)
+        {
+          break;
+        }
+      if(n2 > i)
+        {
+          auto it_str = std::find_if(document.begin() + i,
+                                     document.begin() + n2,
+                                     [](const char &el)
+                                       {
+                                         return el < 0 || el > ' ';
+                                       });
+          if(it_str != document.begin() + n2)
+            {
+              XMLElement content;
+              content.element_type = XMLElement::ElementContent;
+              content.content.assign(document, i, n2 - i);
+              elements.emplace_back(std::move(content));
+            }
+        }
+      i = n2;
+      elements.emplace_back(parseTag(document, i));
+    }
+
+  formResult(result, elements.begin(), elements.end());
+
+  replaceXMLEntities(result);
+
+  return result;
+}
+
+bool
+XMLParserCPP::parseDocumentStream(
+    const std::string &xml_document,
+    std::function<bool(XMLStreamEvent &event)> callback)
+{
+  if(xml_document.size() == 0)
+    {
+      return true;
+    }
+
+  std::string code_page = documentCodePage(xml_document);
+
+  std::string converted;
+  if(code_page != "UTF-8")
+    {
+      XMLTextEncoding::convertToEncoding(xml_document, converted, code_page,
+                                         "UTF-8");
+      if(converted.empty())
+        {
+          throw std::runtime_error("XMLParserCPP::parseDocumentStream: error "
+                                   "on conversion to UTF-8");
+        }
+    }
+  const std::string &document = converted.empty() ? xml_document : converted;
+
+  std::string::size_type n = document.find('<');
+  if(n == std::string::npos)
+    {
+      throw std::runtime_error(
+          "XMLParserCPP::parseDocumentStream: incorrect document(1)");
+    }
 
+  XMLStreamEvent event;
+  size_t depth = 0;
+  size_t limit = document.size();
   for(size_t i = n; i < limit; i++)
     {
+      std::string::size_type n2 = document.find('<', i);
+      if(n2 == std::string::npos)
+        {
+          n2 = limit;
+        }
+      if(n2 > i)
+        {
+          auto it_str = std::find_if(document.begin() + i,
+                                     document.begin() + n2,
+                                     [](const char &el)
+                                       {
+                                         return el < 0 || el > ' ';
+                                       });
+          if(it_str != document.begin() + n2)
+            {
+              event.clear();
+              event.event_type = XMLStreamEvent::Content;
+              event.content = document.substr(i, n2 - i);
+              replacementFunc(event.content);
+              event.depth = depth;
+              if(!callback(event))
+                {
+                  return false;
+                }
+            }
+          if(n2 == limit)
+            {
+              break;
+            }
+          i = n2;
+        }
+
+      bool closing = i + 1 < limit && document[i + 1] == '/';
+      XMLElement element = parseTag(document, i);
+
+      event.clear();
+      event.element_name = std::move(element.element_name);
+      event.element_attributes = std::move(element.element_attributes);
+      event.content = std::move(element.content);
+      switch(element.element_type)
+        {
+        case XMLElement::OrdinaryElement:
+          {
+            if(closing)
+              {
+                if(depth > 0)
+                  {
+                    depth--;
+                  }
+                event.event_type = XMLStreamEvent::EndElement;
+                event.depth = depth;
+                if(!callback(event))
+                  {
+                    return false;
+                  }
+                break;
+              }
+            for(auto it = event.element_attributes.begin();
+                it != event.element_attributes.end(); it++)
+              {
+                replacementFunc(it->attribute_value);
+              }
+            event.event_type = XMLStreamEvent::StartElement;
+            event.depth = depth;
+            if(!callback(event))
+              {
+                return false;
+              }
+            if(element.empty == XMLElement::XML)
+              {
+                event.event_type = XMLStreamEvent::EndElement;
+                event.element_attributes.clear();
+                if(!callback(event))
+                  {
+                    return false;
+                  }
+              }
+            else
+              {
+                depth++;
+              }
+            break;
+          }
+        case XMLElement::ProgramControlElement:
+          {
+            for(auto it = event.element_attributes.begin();
+                it != event.element_attributes.end(); it++)
+              {
+                replacementFunc(it->attribute_value);
+              }
+            event.event_type = XMLStreamEvent::ProgramControlElement;
+            event.depth = depth;
+            if(!callback(event))
+              {
+                return false;
+              }
+            break;
+          }
+        default:
+          {
+            switch(element.element_type)
+              {
+              case XMLElement::CharData:
+                {
+                  event.event_type = XMLStreamEvent::CharData;
+                  break;
+                }
+              case XMLElement::Comment:
+                {
+                  event.event_type = XMLStreamEvent::Comment;
+                  break;
+                }
+              default:
+                {
+                  event.event_type = XMLStreamEvent::SpecialElement;
+                  break;
+                }
+              }
+            event.depth = depth;
+            if(!callback(event))
+              {
+                return false;
+              }
+            break;
+          }
+        }
+    }
+
+  return true;
+}
+
+XMLDocument
+XMLParserCPP::parseDocumentView(std::string xml_document)
+{
+  XMLDocument result;
+  if(xml_document.size() == 0)
+    {
+      return result;
+    }
+
+  std::string code_page = documentCodePage(xml_document);
+  result.buffer.reset(new std::string);
+  if(code_page == "UTF-8")
+    {
+      *result.buffer = std::move(xml_document);
+    }
+  else
+    {
+      XMLTextEncoding::convertToEncoding(xml_document, *result.buffer,
+                                         code_page, "UTF-8");
+      if(result.buffer->empty())
+        {
+          throw std::runtime_error("XMLParserCPP::parseDocumentView: error "
+                                   "on conversion to UTF-8");
+        }
+    }
+  const std::string &document = *result.buffer;
+
+  size_t i = document.find('<');
+  if(i == std::string::npos)
+    {
+      throw std::runtime_error(
+          "XMLParserCPP::parseDocumentView: incorrect document(1)");
+    }
+
+  auto space = [](const char &ch)
+    {
+      return ch >= 0 && ch <= ' ';
+    };
+
+  // Open nodes and their last subnodes.
+  std::vector<std::tuple<XMLNode *, XMLNode *>> stack;
+  stack.reserve(32);
+  XMLNode *last_node = nullptr;
+
+  auto append = [&result, &stack, &last_node](XMLNode *node)
+    {
+      if(stack.size() == 0)
+        {
+          if(last_node)
+            {
+              last_node->next_sibling = node;
+            }
+          else
+            {
+              result.first_node = node;
+            }
+          last_node = node;
+        }
+      else
+        {
+          XMLNode *parent = std::get<0>(*stack.rbegin());
+          XMLNode *&last = std::get<1>(*stack.rbegin());
+          node->parent = parent;
+          if(last)
+            {
+              last->next_sibling = node;
+            }
+          else
+            {
+              parent->first_child = node;
+            }
+          last = node;
+        }
+    };
+
+  // Node without closing tag is considered to be empty HTML node (as in
+  // parseDocument()), its subnodes are moved to the parent node.
+  auto close_unclosed = [&stack, &last_node]()
+    {
+      XMLNode *node = std::get<0>(*stack.rbegin());
+      XMLNode *last_child = std::get<1>(*stack.rbegin());
+      stack.pop_back();
+      node->empty = XMLElement::HTML;
+      if(node->first_child == nullptr)
+        {
+          return void();
+        }
+      for(XMLNode *child = node->first_child; child != nullptr;
+          child = child->next_sibling)
+        {
+          child->parent = node->parent;
+        }
+      node->next_sibling = node->first_child;
+      node->first_child = nullptr;
+      if(stack.size() == 0)
+        {
+          last_node = last_child;
+        }
+      else
+        {
+          std::get<1>(*stack.rbegin()) = last_child;
+        }
+    };
+
+  size_t limit = document.size();
+  while(i < limit)
+    {
+      size_t n = document.find('<', i);
+      if(n == std::string::npos)
+        {
+          n = limit;
+        }
+      if(n > i)
+        {
+          auto it = std::find_if_not(document.begin() + i,
+                                     document.begin() + n, space);
+          if(it != document.begin() + n)
+            {
+              XMLNode *node = result.allocate<XMLNode>();
+              node->node_type = XMLElement::ElementContent;
+              node->content = viewOrDecode(result, i, n);
+              append(node);
+            }
+        }
+      if(n >= limit)
+        {
+          break;
+        }
+
+      i = n + 1;
+      if(i >= limit)
+        {
+          throw std::runtime_error(
+              "XMLParserCPP::parseDocumentView: incorrect document(2)");
+        }
       switch(document[i])
         {
-        case '<':
+        case '!':
+          {
+            XMLNode *node = result.allocate<XMLNode>();
+            parseSpecialView(result, i, node);
+            append(node);
+            break;
+          }
+        case '/':
           {
-            if(!content.content.empty())
+            i++;
+            n = document.find('>', i);
+            if(n == std::string::npos)
+              {
+                throw std::runtime_error(
+                    "XMLParserCPP::parseDocumentView: incorrect document(3)");
+              }
+            size_t end = n;
+            while(end > i && space(document[end - 1]))
               {
-                auto it_str = std::find_if(content.content.begin(),
-                                           content.content.end(),
-                                           [](const char &el)
-                                             {
-                                               return el < 0 || el > ' ';
-                                             });
-                if(it_str != content.content.end())
+                end--;
+              }
+            std::string_view name(document.data() + i, end - i);
+            i = n + 1;
+
+            auto it = std::find_if(stack.rbegin(), stack.rend(),
+                                   [&name](const auto &el)
+                                     {
+                                       return std::get<0>(el)->node_name
+                                              == name;
+                                     });
+            if(it != stack.rend())
+              {
+                XMLNode *node = std::get<0>(*it);
+                while(std::get<0>(*stack.rbegin()) != node)
                   {
-                    elements.emplace_back(content);
+                    close_unclosed();
                   }
-                content = XMLElement();
-                content.element_type = XMLElement::ElementContent;
+                stack.pop_back();
               }
-            elements.emplace_back(parseTag(document, i));
             break;
           }
         default:
           {
-            content.content.push_back(document[i]);
+            XMLNode *node = result.allocate<XMLNode>();
+            if(document[i] == '?')
+              {
+                node->node_type = XMLElement::ProgramControlElement;
+                node->empty = XMLElement::XML;
+                i++;
+              }
+            n = i;
+            while(n < limit && !space(document[n]) && document[n] != '/'
+                  && document[n] != '?' && document[n] != '>')
+              {
+                n++;
+              }
+            node->node_name = std::string_view(document.data() + i, n - i);
+            i = n;
+            bool empty = false;
+            node->first_attribute = parseAttributesView(result, i, empty);
+            append(node);
+            if(empty)
+              {
+                node->empty = XMLElement::XML;
+              }
+            else if(node->node_type == XMLElement::OrdinaryElement)
+              {
+                stack.emplace_back(std::make_tuple(node, nullptr));
+              }
             break;
           }
         }
     }
 
-  formResult(result, elements.begin(), elements.end());
+  while(stack.size() > 0)
+    {
+      close_unclosed();
+    }
 
-  replaceXMLEntities(result);
+  return result;
+}
+
+void
+XMLParserCPP::parseSpecialView(XMLDocument &doc, size_t &position,
+                               XMLNode *node)
+{
+  const std::string &document = *doc.buffer;
+  // position points to '!'
+  size_t start;
+  size_t end;
+  if(document.compare(position, 8, "![CDATA[") == 0)
+    {
+      node->node_type = XMLElement::CharData;
+      start = position + 8;
+      end = document.find("]]>", start);
+      if(end == std::string::npos)
+        {
+          throw std::runtime_error("XMLParserCPP::parseSpecialView: "
+                                   "CDATA element has not been completed");
+        }
+      node->content = std::string_view(document.data() + start, end - start);
+      position = end + 3;
+      return void();
+    }
+  else if(document.compare(position, 3, "!--") == 0)
+    {
+      node->node_type = XMLElement::Comment;
+      start = position + 3;
+      end = document.find("-->", start);
+      if(end == std::string::npos)
+        {
+          throw std::runtime_error("XMLParserCPP::parseSpecialView: "
+                                   "comment element has not been completed");
+        }
+      position = end + 3;
+    }
+  else
+    {
+      node->node_type = XMLElement::SpecialElement;
+      start = position + 1;
+      end = document.find('>', start);
+      if(end == std::string::npos)
+        {
+          throw std::runtime_error("XMLParserCPP::parseSpecialView: "
+                                   "special element has not been completed");
+        }
+      position = end + 1;
+    }
+
+  while(start < end && document[start] >= 0 && document[start] <= ' ')
+    {
+      start++;
+    }
+  while(end > start && document[end - 1] >= 0 && document[end - 1] <= ' ')
+    {
+      end--;
+    }
+  node->content = std::string_view(document.data() + start, end - start);
+}
+
+XMLNodeAttribute *
+XMLParserCPP::parseAttributesView(XMLDocument &doc, size_t &position,
+                                  bool &empty)
+{
+  const std::string &document = *doc.buffer;
+  size_t limit = document.size();
+  auto space = [](const char &ch)
+    {
+      return ch >= 0 && ch <= ' ';
+    };
+  auto skip_space = [&document, &position, &limit, &space]()
+    {
+      while(position < limit && space(document[position]))
+        {
+          position++;
+        }
+      if(position >= limit)
+        {
+          throw std::runtime_error("XMLParserCPP::parseAttributesView: "
+                                   "tag has not been completed");
+        }
+    };
+
+  XMLNodeAttribute *first = nullptr;
+  XMLNodeAttribute *last = nullptr;
+  for(;;)
+    {
+      skip_space();
+      switch(document[position])
+        {
+        case '>':
+          {
+            position++;
+            return first;
+          }
+        case '/':
+        case '?':
+          {
+            empty = true;
+            position++;
+            continue;
+          }
+        default:
+          break;
+        }
+
+      XMLNodeAttribute *attr = doc.allocate<XMLNodeAttribute>();
+      size_t start = position;
+      while(position < limit && !space(document[position])
+            && document[position] != '=' && document[position] != '>'
+            && document[position] != '/' && document[position] != '?')
+        {
+          position++;
+        }
+      attr->attribute_id
+          = std::string_view(document.data() + start, position - start);
+      skip_space();
+      if(document[position] == '=')
+        {
+          position++;
+          skip_space();
+          char quote = document[position];
+          if(quote != '\"' && quote != '\'')
+            {
+              throw std::runtime_error("XMLParserCPP::parseAttributesView: "
+                                       "incorrect attribute");
+            }
+          size_t end = document.find(quote, position + 1);
+          if(end == std::string::npos)
+            {
+              throw std::runtime_error("XMLParserCPP::parseAttributesView: "
+                                       "attribute has not been completed");
+            }
+          attr->attribute_value = viewOrDecode(doc, position + 1, end);
+          position = end + 1;
+        }
+
+      if(last)
+        {
+          last->next = attr;
+        }
+      else
+        {
+          first = attr;
+        }
+      last = attr;
+    }
+}
+
+std::string_view
+XMLParserCPP::viewOrDecode(XMLDocument &doc, const size_t &start,
+                           const size_t &end)
+{
+  std::string_view result(doc.buffer->data() + start, end - start);
+  if(result.find('&') != std::string_view::npos)
+    {
+      std::string str;
+      decodeEntities(result, str);
+      result = doc.storeString(std::move(str));
+    }
 
   return result;
 }
 
+std::string
+XMLParserCPP::documentCodePage(const std::string &xml_document)
+{
+  std::string cp = XMLTextEncoding::detectDocumentEncoding(xml_document);
+  if(cp.empty())
+    {
+      throw std::runtime_error("XMLParserCPP::documentCodePage: cannot "
+                               "determine document encoding");
+    }
+
+  return cp;
+}
+
 void
 XMLParserCPP::replaceXMLEntities(std::vector<XMLElement> &elements)
 {
@@ -138,116 +680,143 @@ XMLParserCPP::replaceXMLEntities(std::vector<XMLElement> &elements)
 void
 XMLParserCPP::replacementFunc(std::string &str)
 {
-  if(str.size() == 0)
+  if(str.find('&') != std::string::npos)
     {
-      return void();
+      std::string result;
+      decodeEntities(str, result);
+      str = std::move(result);
     }
-  std::string find_str("&");
-  std::string find_str2(";");
-  std::string::size_type n = 0;
-  std::string::size_type n2;
-  for(;;)
+  str.shrink_to_fit();
+}
+
+void
+XMLParserCPP::decodeEntities(std::string_view source, std::string &result)
+{
+  result.clear();
+  result.reserve(source.size());
+
+  // Predefined XML entities. Table is constant, so it is shared by all
+  // XMLParserCPP objects instead of being built in each constructor.
+  static constexpr std::array<std::tuple<std::string_view, std::string_view>,
+                              5>
+      replacement = { std::make_tuple("amp", "&"),
+                      std::make_tuple("apos", "'"),
+                      std::make_tuple("gt", ">"),
+                      std::make_tuple("lt", "<"),
+                      std::make_tuple("quot", "\"") };
+
+  size_t limit = source.size();
+  size_t i = 0;
+  while(i < limit)
     {
-      n = str.find(find_str, n);
-      if(n == std::string::npos)
+      std::string_view::size_type n = source.find('&', i);
+      if(n == std::string_view::npos)
         {
+          result.append(source.data() + i, limit - i);
           break;
         }
-      n2 = str.find(find_str2, n);
-      if(n2 == std::string::npos)
+      result.append(source.data() + i, n - i);
+      i = n + 1;
+
+      // Reference is searched within length of the longest valid reference
+      // only, so bare '&' symbols do not make decoding quadratic.
+      std::string_view::size_type n2 = std::string_view::npos;
+      size_t scan_lim = std::min(limit, i + 32);
+      for(size_t j = i; j < scan_lim; j++)
         {
-          break;
+          char ch = source[j];
+          if(ch == ';')
+            {
+              n2 = j;
+              break;
+            }
+          if(ch == '&' || ch == '<' || (ch >= 0 && ch <= ' '))
+            {
+              break;
+            }
+        }
+      if(n2 == std::string_view::npos)
+        {
+          result.push_back('&');
+          continue;
         }
-      std::string to_replace(str.begin() + n + find_str.size(),
-                             str.begin() + n2);
+      std::string_view to_replace = source.substr(i, n2 - i);
+
       auto it = std::find_if(
           replacement.begin(), replacement.end(),
-          [to_replace](const std::tuple<std::string, std::string> &el)
+          [to_replace](
+              const std::tuple<std::string_view, std::string_view> &el)
             {
               return to_replace == std::get<0>(el);
             });
       if(it != replacement.end())
         {
-          str.erase(str.begin() + n, str.begin() + n2 + find_str2.size());
-          str.insert(str.begin() + n, std::get<1>(*it).begin(),
-                     std::get<1>(*it).end());
+          result += std::get<1>(*it);
+          i = n2 + 1;
+          continue;
         }
-      else
+
+      if(to_replace.size() >= 2 && to_replace[0] == '#')
         {
-          if(to_replace.size() >= 2)
+          uint32_t ch = 0;
+          std::from_chars_result conv;
+          if(to_replace[1] == 'x')
             {
-              if(to_replace[0] == '#')
-                {
-                  if(to_replace[1] == 'x')
-                    {
-                      to_replace.erase(to_replace.begin(),
-                                       to_replace.begin() + 2);
-                      if(to_replace.size() > 0)
-                        {
-                          std::stringstream strm;
-                          strm.imbue(std::locale("C"));
-                          strm << std::hex << str;
-                          UChar32 ch;
-                          strm >> ch;
-                          icu::UnicodeString ustr(ch);
-                          to_replace.clear();
-                          ustr.toUTF8String(to_replace);
-                          str.erase(str.begin() + n,
-                                    str.begin() + n2 + find_str2.size());
-                          str.insert(str.begin() + n, to_replace.begin(),
-                                     to_replace.end());
-                        }
-                      else
-                        {
-                          n++;
-                        }
-                    }
-                  else
-                    {
-                      to_replace.erase(to_replace.begin());
-                      bool num = true;
-                      for(auto it_tr = to_replace.begin();
-                          it_tr != to_replace.end(); it_tr++)
-                        {
-                          if((*it_tr) < 48 || (*it_tr) > 57)
-                            {
-                              num = false;
-                              break;
-                            }
-                        }
-                      if(num)
-                        {
-                          std::stringstream strm;
-                          strm.imbue(std::locale("C"));
-                          strm.str(to_replace);
-                          UChar32 ch;
-                          strm >> ch;
-                          icu::UnicodeString ustr(ch);
-                          to_replace.clear();
-                          ustr.toUTF8String(to_replace);
-                          str.erase(str.begin() + n,
-                                    str.begin() + n2 + find_str2.size());
-                          str.insert(str.begin() + n, to_replace.begin(),
-                                     to_replace.end());
-                        }
-                      else
-                        {
-                          n++;
-                        }
-                    }
-                }
-              else
-                {
-                  n++;
-                }
+              conv = std::from_chars(to_replace.data() + 2,
+                                     to_replace.data() + to_replace.size(),
+                                     ch, 16);
             }
           else
             {
-              n++;
+              conv = std::from_chars(to_replace.data() + 1,
+                                     to_replace.data() + to_replace.size(),
+                                     ch, 10);
+            }
+          if(conv.ec == std::errc()
+             && conv.ptr == to_replace.data() + to_replace.size()
+             && appendUTF8(ch, result))
+            {
+              i = n2 + 1;
+              continue;
             }
         }
+
+      result.push_back('&');
     }
-  str.shrink_to_fit();
+}
+
+bool
+XMLParserCPP::appendUTF8(const uint32_t &ch, std::string &result)
+{
+  if(ch == 0 || ch > 0x10FFFF || (ch >= 0xD800 && ch <= 0xDFFF))
+    {
+      return false;
+    }
+
+  if(ch < 0x80)
+    {
+      result.push_back(static_cast<char>(ch));
+    }
+  else if(ch < 0x800)
+    {
+      result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+      result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+  else if(ch < 0x10000)
+    {
+      result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+  else
+    {
+      result.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+
+  return true;
 }
 
 XMLElement
@@ -374,8 +943,7 @@ XMLParserCPP::parseSpecialElement(const std::string &document,
             throw std::runtime_error("XMLParserCPP::parseSpecialElement: "
                                      "CDATA element has not been completed");
           }
-        std::copy(document.begin() + n, document.begin() + n2,
-                  std::back_inserter(element.content));
+        element.content.assign(document, n, n2 - n);
         position = n2 + find_str.size() - 1;
         break;
       }
@@ -396,40 +964,20 @@ XMLParserCPP::parseSpecialElement(const std::string &document,
             throw std::runtime_error("XMLParserCPP::parseSpecialElement: "
                                      "comment element has not been completed");
           }
-        std::copy(document.begin() + position, document.begin() + n,
-                  std::back_inserter(element.content));
+        element.content.assign(document, position, n - position);
         position = n + find_str.size() - 1;
         break;
       }
     default:
       {
-        bool stop = false;
-
-        for(; position < document.size(); position++)
-          {
-            switch(document[position])
-              {
-              case '>':
-                {
-                  stop = true;
-                  break;
-                }
-              default:
-                {
-                  element.content.push_back(document[position]);
-                  break;
-                }
-              }
-            if(stop)
-              {
-                break;
-              }
-          }
-        if(!stop)
+        std::string::size_type n = document.find('>', position);
+        if(n == std::string::npos)
           {
             throw std::runtime_error("XMLParserCPP::parseSpecialElement: "
                                      "special element has not bin completed");
           }
+        element.content.assign(document, position, n - position);
+        position = n;
         break;
       }
     }
@@ -480,32 +1028,14 @@ XMLParserCPP::parseElementAttribute(const std::string &document,
           "XMLParserCPP::parseElementAttribute: incorrect attribute(1)");
     }
 
-  bool stop = false;
-  for(; position < limit; position++)
-    {
-      switch(document[position])
-        {
-        case '=':
-          {
-            stop = true;
-            break;
-          }
-        default:
-          {
-            result.attribute_id.push_back(document[position]);
-            break;
-          }
-        }
-      if(stop)
-        {
-          break;
-        }
-    }
-  if(position >= limit)
+  std::string::size_type n = document.find('=', position);
+  if(n == std::string::npos)
     {
       throw std::runtime_error(
           "XMLParserCPP::parseElementAttribute: incorrect attribute(2)");
     }
+  result.attribute_id.assign(document, position, n - position);
+  position = n;
 
   while(result.attribute_id.size() > 0)
     {
@@ -519,40 +1049,23 @@ XMLParserCPP::parseElementAttribute(const std::string &document,
         }
     }
 
-  char attr_end;
-  for(; position < limit; position++)
-    {
-      attr_end = document[position];
-      if(attr_end == '\'' || attr_end == '\"')
-        {
-          break;
-        }
-    }
-  position++;
-  if(position >= limit)
+  n = document.find_first_of("\"'", position);
+  if(n == std::string::npos || n + 1 >= limit)
     {
       throw std::runtime_error(
           "XMLParserCPP::parseElementAttribute: incorrect attribute(3)");
     }
+  char attr_end = document[n];
+  position = n + 1;
 
-  for(; position < limit; position++)
-    {
-      char el = document[position];
-      if(el == attr_end)
-        {
-          break;
-        }
-      else
-        {
-          result.attribute_value.push_back(el);
-        }
-    }
-
-  if(position >= limit)
+  n = document.find(attr_end, position);
+  if(n == std::string::npos)
     {
       throw std::runtime_error(
           "XMLParserCPP::parseElementAttribute: incorrect attribute(4)");
     }
+  result.attribute_value.assign(document, position, n - position);
+  position = n;
 
   return result;
 }
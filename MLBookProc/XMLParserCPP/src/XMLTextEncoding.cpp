@@ -15,25 +15,196 @@
  */
 
 #include <XMLTextEncoding.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <unicode/ucnv.h>
 #include <unicode/ucsdet.h>
 
 std::string
-XMLTextEncoding::detectDocumentEncoding(const std::string &document)
+XMLTextEncoding::detectDocumentEncoding(const std::string &document,
+                                        const size_t &sniff_limit)
+{
+  std::string result = XMLTextEncoding::detectBOMEncoding(document);
+  if(!result.empty())
+    {
+      return result;
+    }
+
+  size_t prefix_sz = std::min(document.size(), sniff_limit);
+  std::string_view prefix(document.data(), prefix_sz);
+  // NUL bytes in prefix mean UTF-16 or UTF-32 without byte order mark, so
+  // neither XML header nor UTF-8 check can be trusted.
+  bool wide = prefix.find('\0') != std::string_view::npos;
+
+  if(!wide)
+    {
+      result = XMLTextEncoding::declaredEncoding(document);
+      if(!result.empty())
+        {
+          if(ucnv_compareNames(result.c_str(), "UTF-8") != 0)
+            {
+              return result;
+            }
+          else if(XMLTextEncoding::isValidUTF8(document))
+            {
+              return std::string("UTF-8");
+            }
+        }
+      else if(XMLTextEncoding::isValidUTF8(document))
+        {
+          return std::string("UTF-8");
+        }
+    }
+
+  std::cout << "XMLTextEncoding::detectDocumentEncoding: using fallback method"
+            << std::endl;
+  result.clear();
+  std::vector<std::string> res = XMLTextEncoding::detectStringEncoding(
+      std::string(prefix.begin(), prefix.end()), true);
+  if(res.size() > 0)
+    {
+      result = res[0];
+    }
+
+  return result;
+}
+
+std::string
+XMLTextEncoding::detectBOMEncoding(const std::string &str)
+{
+  std::string result;
+  const unsigned char *b
+      = reinterpret_cast<const unsigned char *>(str.c_str());
+  if(str.size() >= 4)
+    {
+      if(b[0] == 0xFF && b[1] == 0xFE && b[2] == 0x00 && b[3] == 0x00)
+        {
+          result = "UTF-32LE";
+          return result;
+        }
+      if(b[0] == 0x00 && b[1] == 0x00 && b[2] == 0xFE && b[3] == 0xFF)
+        {
+          result = "UTF-32BE";
+          return result;
+        }
+    }
+  if(str.size() >= 3)
+    {
+      if(b[0] == 0xEF && b[1] == 0xBB && b[2] == 0xBF)
+        {
+          result = "UTF-8";
+          return result;
+        }
+    }
+  if(str.size() >= 2)
+    {
+      if(b[0] == 0xFF && b[1] == 0xFE)
+        {
+          result = "UTF-16LE";
+        }
+      else if(b[0] == 0xFE && b[1] == 0xFF)
+        {
+          result = "UTF-16BE";
+        }
+    }
+
+  return result;
+}
+
+bool
+XMLTextEncoding::isValidUTF8(const std::string &str)
+{
+  const unsigned char *b
+      = reinterpret_cast<const unsigned char *>(str.c_str());
+  size_t sz = str.size();
+  size_t i = 0;
+  while(i < sz)
+    {
+      // ASCII fast path: check eight bytes at once.
+      if(i + 8 <= sz)
+        {
+          uint64_t chunk;
+          std::memcpy(&chunk, b + i, sizeof(chunk));
+          if((chunk & uint64_t(0x8080808080808080)) == 0)
+            {
+              i += 8;
+              continue;
+            }
+        }
+      unsigned char c = b[i];
+      if(c < 0x80)
+        {
+          i++;
+          continue;
+        }
+
+      size_t len;
+      uint32_t cp;
+      if(c >= 0xC2 && c <= 0xDF)
+        {
+          len = 2;
+          cp = c & 0x1F;
+        }
+      else if(c >= 0xE0 && c <= 0xEF)
+        {
+          len = 3;
+          cp = c & 0x0F;
+        }
+      else if(c >= 0xF0 && c <= 0xF4)
+        {
+          len = 4;
+          cp = c & 0x07;
+        }
+      else
+        {
+          return false;
+        }
+      if(i + len > sz)
+        {
+          return false;
+        }
+      for(size_t j = 1; j < len; j++)
+        {
+          if((b[i + j] & 0xC0) != 0x80)
+            {
+              return false;
+            }
+          cp = (cp << 6) | (b[i + j] & 0x3F);
+        }
+      if((len == 3 && cp < 0x800) || (len == 4 && cp < 0x10000)
+         || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+        {
+          return false;
+        }
+      i += len;
+    }
+
+  return true;
+}
+
+std::string
+XMLTextEncoding::declaredEncoding(const std::string &document)
 {
   std::string result;
 
+  // XML header can only be preceded by byte order mark and white spaces.
+  std::string_view prefix(document.data(),
+                          std::min(document.size(), size_t(1024)));
+
   std::string find_str1("<?xml");
-  std::string::size_type n1 = document.find(find_str1);
+  std::string::size_type n1 = prefix.find(find_str1);
   if(n1 == std::string::npos)
     {
       return result;
     }
   std::string find_str2("?>");
-  std::string::size_type n2 = document.find(find_str2, n1 + find_str1.size());
+  std::string::size_type n2 = prefix.find(find_str2, n1 + find_str1.size());
   if(n2 == std::string::npos)
     {
       return result;
@@ -143,16 +314,7 @@ XMLTextEncoding::detectDocumentEncoding(const std::string &document)
     }
   if(!stop)
     {
-      std::cout
-          << "XMLTextEncoding::detectDocumentEncoding: using fallback method"
-          << std::endl;
       result.clear();
-      std::vector<std::string> res
-          = XMLTextEncoding::detectStringEncoding(document, true);
-      if(res.size() > 0)
-        {
-          result = res[0];
-        }
     }
   return result;
 }
@@ -245,72 +407,27 @@ XMLTextEncoding::convertToEncoding(const std::string &source,
       return void();
     }
 
-  UErrorCode e_code = U_ZERO_ERROR;
-  std::unique_ptr<UConverter, std::function<void(UConverter * conv)>>
-      source_converter;
-
-  if(source_code_page.empty())
-    {
-      source_converter
-          = std::unique_ptr<UConverter, std::function<void(UConverter *)>>(
-              ucnv_open(nullptr, &e_code),
-              [](UConverter *conv)
-                {
-                  ucnv_close(conv);
-                });
-    }
-  else
-    {
-      source_converter
-          = std::unique_ptr<UConverter, std::function<void(UConverter *)>>(
-              ucnv_open(source_code_page.c_str(), &e_code),
-              [](UConverter *conv)
-                {
-                  ucnv_close(conv);
-                });
-    }
-  if(U_FAILURE(e_code))
+  if(ucnv_compareNames(source_code_page.c_str(), "UTF-8") == 0
+     && ucnv_compareNames(result_code_page.c_str(), "UTF-8") == 0
+     && XMLTextEncoding::isValidUTF8(source))
     {
-      std::string e_str(
-          "XMLTextEncoding::convertToEncoding source converter: ");
-      e_str += u_errorName(e_code);
-      std::cout << e_str << std::endl;
+      result = source;
       return void();
     }
 
-  e_code = U_ZERO_ERROR;
-  std::unique_ptr<UConverter, std::function<void(UConverter * conv)>>
-      result_converter;
-
-  if(result_code_page.empty())
-    {
-      result_converter
-          = std::unique_ptr<UConverter, std::function<void(UConverter *)>>(
-              ucnv_open(nullptr, &e_code),
-              [](UConverter *conv)
-                {
-                  ucnv_close(conv);
-                });
-    }
-  else
+  UConverter *source_converter = XMLTextEncoding::converter(source_code_page);
+  if(source_converter == nullptr)
     {
-      result_converter
-          = std::unique_ptr<UConverter, std::function<void(UConverter *)>>(
-              ucnv_open(result_code_page.c_str(), &e_code),
-              [](UConverter *conv)
-                {
-                  ucnv_close(conv);
-                });
+      return void();
     }
-  if(U_FAILURE(e_code))
+
+  UConverter *result_converter = XMLTextEncoding::converter(result_code_page);
+  if(result_converter == nullptr)
     {
-      std::string e_str(
-          "XMLTextEncoding::convertToEncoding result converter: ");
-      e_str += u_errorName(e_code);
-      std::cout << e_str << std::endl;
       return void();
     }
 
+  UErrorCode e_code;
   std::vector<UChar> res;
   res.resize(source.size());
   UChar *start_res = res.data();
@@ -318,7 +435,7 @@ XMLTextEncoding::convertToEncoding(const std::string &source,
   for(;;)
     {
       e_code = U_ZERO_ERROR;
-      ucnv_toUnicode(source_converter.get(), &start_res, res.end().base(),
+      ucnv_toUnicode(source_converter, &start_res, res.end().base(),
                      &start_src, source.end().base(), nullptr, true, &e_code);
       if(U_SUCCESS(e_code))
         {
@@ -351,9 +468,9 @@ XMLTextEncoding::convertToEncoding(const std::string &source,
   for(;;)
     {
       e_code = U_ZERO_ERROR;
-      ucnv_fromUnicode(result_converter.get(), &start_result,
-                       result.end().base(), &start_res_const, res.end().base(),
-                       nullptr, true, &e_code);
+      ucnv_fromUnicode(result_converter, &start_result, result.end().base(),
+                       &start_res_const, res.end().base(), nullptr, true,
+                       &e_code);
       if(U_SUCCESS(e_code))
         {
           break;
@@ -381,3 +498,40 @@ XMLTextEncoding::convertToEncoding(const std::string &source,
   result.erase(std::string::iterator(start_result), result.end());
   result.shrink_to_fit();
 }
+
+UConverter *
+XMLTextEncoding::converter(const std::string &code_page)
+{
+  thread_local std::unordered_map<
+      std::string,
+      std::unique_ptr<UConverter, std::function<void(UConverter *)>>>
+      converters;
+
+  auto it = converters.find(code_page);
+  if(it != converters.end())
+    {
+      ucnv_reset(it->second.get());
+      return it->second.get();
+    }
+
+  UErrorCode e_code = U_ZERO_ERROR;
+  std::unique_ptr<UConverter, std::function<void(UConverter *)>> conv(
+      ucnv_open(code_page.empty() ? nullptr : code_page.c_str(), &e_code),
+      [](UConverter *conv)
+        {
+          ucnv_close(conv);
+        });
+  if(U_FAILURE(e_code))
+    {
+      std::string e_str("XMLTextEncoding::converter: ");
+      e_str += u_errorName(e_code);
+      e_str += " (" + code_page + ")";
+      std::cout << e_str << std::endl;
+      return nullptr;
+    }
+
+  UConverter *result = conv.get();
+  converters.emplace(code_page, std::move(conv));
+
+  return result;
+}
@@ -19,6 +19,7 @@
 #include <BaseID.h>
 #include <LibArchive.h>
 #include <MLBookProc.h>
+#include <ParserPool.h>
 #include <UDBElement.h>
 #include <archive_entry.h>
 #include <atomic>
@@ -44,18 +45,26 @@ public:
    * numbers and their current busy status.
    * \param thread_v_mtx Smart pointer to mutex, locking `thread_v` vector.
    * \param thread_v_var Condition variable, locking `thread_v` vector.
+   * \param parser_pool Optional smart pointer to ParserPool object to take
+   * parsers from (own pool is created if not set).
    */
   ArchiveParser(
       const std::shared_ptr<MLBookProc> &mlbp,
       const std::shared_ptr<std::vector<std::tuple<unsigned, bool>>> &thread_v,
       const std::shared_ptr<std::mutex> &thread_v_mtx,
-      const std::shared_ptr<std::condition_variable> &thread_v_var);
+      const std::shared_ptr<std::condition_variable> &thread_v_var,
+      const std::shared_ptr<ParserPool> &parser_pool = nullptr);
 
   virtual ~ArchiveParser();
 
   /*!
    * Parses given archive.
    *
+   * Zip archives are split by central directory entries into ranges, each
+   * range is read by its own worker with independent file handle (if free
+   * processors are available in `thread_v`). Other archives are read
+   * sequentially.
+   *
    * \param file_path Path to archive.
    * \return Vector of UDBElement objects, containing obtained information.
    */
@@ -69,8 +78,20 @@ public:
   stopAll();
 
 private:
+  bool
+  parseZipParallel(const std::filesystem::path &file_path);
+
+  void
+  parseZipRange(
+      const std::filesystem::path &file_path,
+      const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &range);
+
+  bool
+  sameEntry(const std::shared_ptr<archive_entry> &e, const std::string &name);
+
   void
-  parseEntry(std::shared_ptr<archive> a, std::shared_ptr<archive_entry> e);
+  parseEntry(std::shared_ptr<archive> a, std::shared_ptr<archive_entry> e,
+             const bool &check_size = true);
 
   enum FileType
   {
@@ -95,12 +116,15 @@ private:
 
   std::atomic<bool> cancel;
 
-  std::shared_ptr<ArchiveParser> arch_proc;
+  std::vector<std::shared_ptr<ArchiveParser>> arch_proc;
+  std::mutex arch_proc_mtx;
 
   std::shared_ptr<std::vector<std::tuple<unsigned, bool>>> thread_v;
   std::shared_ptr<std::mutex> thread_v_mtx;
   std::shared_ptr<std::condition_variable> thread_v_var;
 
+  std::shared_ptr<ParserPool> parser_pool;
+
   int thr_num = 0;
   std::mutex thr_num_mtx;
   std::condition_variable thr_num_var;
@@ -72,6 +72,33 @@ public:
   setDPI(const double &horizontal_dpi = double(72.0),
          const double &vertical_dpi = double(72.0));
 
+  /*!
+   * Sets maximum size of covers rendered from book pages (pdf and djvu
+   * books). Pages are rendered directly at reduced resolution, so that cover
+   * fits into given size keeping aspect ratio. This method should be called
+   * before getBookInfo().
+   *
+   * Zero values mean no limit (default).
+   *
+   * \param max_width Maximum cover width in pixels.
+   * \param max_height Maximum cover height in pixels.
+   */
+  void
+  setCoverSize(const int &max_width = 0, const int &max_height = 0);
+
+  /*!
+   * Enables or disables rendering of covers from book pages (pdf and djvu
+   * books). Can be used to skip most expensive part of getBookInfo() if cover
+   * has already been obtained from elsewhere (for example, from cache).
+   * Covers stored in books as images are returned in any case.
+   *
+   * Rendering is enabled by default.
+   *
+   * \param render If \a false, pages are not rendered.
+   */
+  void
+  setCoverRendering(const bool &render);
+
   /*!
    * Returns horizontal DPI.
    * \return Horizontal DPI.
@@ -91,11 +118,25 @@ private:
   UDBase
   bookInfo(const std::filesystem::path &p, const UDBElement &path);
 
+  UDBase
+  archiveInfo(const std::filesystem::path &archive_path,
+              const std::string &archive_buffer,
+              const MLBookProc::FileFormat &format, const UDBElement &path);
+
+  UDBase
+  bufferInfo(const std::string &buf, const std::string &file_name,
+             const UDBElement &path);
+
   std::shared_ptr<MLBookProc> mlbp;
 
   double horizontal_dpi = 72.0;
   double vertical_dpi = 72.0;
 
+  int max_cover_width = 0;
+  int max_cover_height = 0;
+
+  bool render_cover = true;
+
   BaseID bid;
 };
 
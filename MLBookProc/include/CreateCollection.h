@@ -244,7 +244,8 @@ protected:
   /*!
    * Calcultes hash sum for given BaseID::File object.
    *
-   * Caller can provide \a file_path ot \a buf on his choice.
+   * Caller can provide \a file_path ot \a buf on his choice. If \a buf is
+   * empty, file is hashed from disk in chunks (see fileHash()).
    *
    * \param file Pointer to BaseID::File object.
    * \param file_path Path to file hash sum to be calculated for.
@@ -261,6 +262,14 @@ protected:
    */
   std::shared_ptr<MLBookProc> mlbp;
 
+  /*!
+   * Smart pointer to ParserPool object. It is shared with ArchiveParser
+   * objects.
+   *
+   * \warning Do not set or modify this object yourself.
+   */
+  std::shared_ptr<ParserPool> parser_pool;
+
   /*!
    * Smart pointer to processors identificators buffer.
    *
@@ -26,6 +26,9 @@
  * Auxiliary class containing pointer to ddjvu_context_t object and support
  * objects. See DJVUParser source code for examples of usage.
  *
+ * Each object has own message queue. Objects are leased to one thread at a
+ * time by MLBookProc::getDJVUContext, so threads do not compete for messages.
+ *
  * \warning Do not create this class objects yourself. If you need this class
  * object, it should be obtained from MLBookProc::getDJVUContext method only.
  */
@@ -51,9 +54,14 @@ public:
   std::mutex context_mtx;
 
   /*!
-   * This object locking condition varibale.
+   * This object locking condition varibale. It is notified each time new
+   * message appears in \a context queue.
    */
   std::condition_variable context_var;
+
+private:
+  static void
+  messageCallback(ddjvu_context_t *context, void *closure);
 };
 
 #endif // DJVUCONTEXT_H
@@ -19,6 +19,7 @@
 #include <BaseID.h>
 #include <MLBookProc.h>
 #include <UDBase.h>
+#include <filesystem>
 #include <libdjvu/ddjvuapi.h>
 
 /*!
@@ -45,6 +46,16 @@ public:
   UDBElement
   parseBook(const std::string &book_content);
 
+  /*!
+   * Parses djvu file directly from disk. Only document directory and
+   * annotations are read, page images are not loaded.
+   *
+   * \param file_path Path to djvu file.
+   * \return BaseID::Book object.
+   */
+  UDBElement
+  parseBook(const std::filesystem::path &file_path);
+
   /*!
    * Obtains extra information from djvu file.
    *
@@ -54,7 +65,50 @@ public:
   UDBase
   getBookInfo(const std::string &book_content);
 
+  /*!
+   * Obtains extra information from djvu file directly from disk. Only
+   * chunks needed for annotations and first page are read.
+   *
+   * \param file_path Path to djvu file.
+   * \return UDBase object containing informatiton (see BookInfo).
+   */
+  UDBase
+  getBookInfo(const std::filesystem::path &file_path);
+
+  /*!
+   * Sets maximum cover size (see BookInfo::setCoverSize).
+   *
+   * \param max_width Maximum cover width in pixels.
+   * \param max_height Maximum cover height in pixels.
+   */
+  void
+  setCoverSize(const int &max_width = 0, const int &max_height = 0);
+
+  /*!
+   * Enables or disables cover rendering (see BookInfo::setCoverRendering).
+   *
+   * \param render If \a false, first page is not rendered.
+   */
+  void
+  setCoverRendering(const bool &render);
+
 private:
+  std::shared_ptr<ddjvu_document_t>
+  createDocument(const std::shared_ptr<DJVUContext> &ctx,
+                 const std::string &book_content);
+
+  std::shared_ptr<ddjvu_document_t>
+  openDocument(const std::shared_ptr<DJVUContext> &ctx,
+               const std::filesystem::path &file_path);
+
+  UDBElement
+  parseDocument(const std::shared_ptr<DJVUContext> &ctx,
+                const std::shared_ptr<ddjvu_document_t> &doc);
+
+  UDBase
+  documentInfo(const std::shared_ptr<DJVUContext> &ctx,
+               const std::shared_ptr<ddjvu_document_t> &doc);
+
   bool
   setBookContentToStream(const std::shared_ptr<DJVUContext> &ctx,
                          const std::shared_ptr<ddjvu_document_t> &doc,
@@ -73,6 +127,11 @@ private:
 
   std::shared_ptr<MLBookProc> mlbp;
 
+  int max_cover_width = 0;
+  int max_cover_height = 0;
+
+  bool render_cover = true;
+
   BaseID bid;
 };
 
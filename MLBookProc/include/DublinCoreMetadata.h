@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DUBLINCOREMETADATA_H
+#define DUBLINCOREMETADATA_H
+
+#include <UDBElement.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief The DublinCoreMetadata class.
+ *
+ * Auxiliary class. Contains all metadata found by
+ * DublinCoreParser::dcParse().
+ */
+class DublinCoreMetadata
+{
+public:
+  /*!
+   * \brief DublinCoreMetadata constructor.
+   */
+  DublinCoreMetadata();
+
+  /*!
+   * \brief BaseID::BookTitle objects.
+   */
+  std::vector<UDBElement> title;
+
+  /*!
+   * \brief BaseID::Author objects.
+   */
+  std::vector<UDBElement> author;
+
+  /*!
+   * \brief BaseID::Genre objects.
+   */
+  std::vector<UDBElement> genre;
+
+  /*!
+   * \brief BaseID::Date objects.
+   */
+  std::vector<UDBElement> date;
+
+  /*!
+   * \brief Book description (not normalized).
+   */
+  std::string description;
+
+  /*!
+   * \brief BaseID::Language objects.
+   */
+  std::vector<UDBElement> language;
+
+  /*!
+   * \brief BaseID::Translator objects.
+   */
+  std::vector<UDBElement> translator;
+
+  /*!
+   * \brief BaseID::EbookPublisher objects.
+   */
+  std::vector<UDBElement> publisher;
+
+  /*!
+   * \brief BaseID::EbookID objects.
+   */
+  std::vector<UDBElement> identifier;
+
+  /*!
+   * \brief BaseID::SourceBookDublinCore objects.
+   */
+  std::vector<UDBElement> source;
+};
+
+#endif // DUBLINCOREMETADATA_H
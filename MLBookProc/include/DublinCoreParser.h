@@ -17,8 +17,10 @@
 #define DUBLINCOREPARSER_H
 
 #include <BaseID.h>
+#include <DublinCoreMetadata.h>
 #include <UDBElement.h>
 #include <XMLParserCPP.h>
+#include <array>
 
 /*!
  * \brief The DublinCoreParser class
@@ -39,6 +41,35 @@ public:
 
   virtual ~DublinCoreParser();
 
+  /*!
+   * Obtains all supported metadata.
+   *
+   * Elements are walked only once, every found `dc:*` element is passed to
+   * corresponding builder. Use this method instead of separate dc* methods if
+   * more than one kind of metadata is needed.
+   *
+   * \param elements Parsed <a
+   * href="https://www.dublincore.org/">DublinCore</a> file.
+   * \return DublinCoreMetadata object.
+   */
+  DublinCoreMetadata
+  dcParse(const std::vector<XMLElement> &elements);
+
+  /*!
+   * Obtains all supported metadata from document parsed by
+   * XMLParserCPP::parseDocumentView().
+   *
+   * Same as dcParse(const std::vector<XMLElement> &), but no copy of document
+   * is made. DublinCoreMetadata::description is not filled: use previous
+   * method if description is needed.
+   *
+   * \param document Parsed <a
+   * href="https://www.dublincore.org/">DublinCore</a> file.
+   * \return DublinCoreMetadata object.
+   */
+  DublinCoreMetadata
+  dcParse(const XMLDocument &document);
+
   /*!
    * Obtains book title.
    *
@@ -140,22 +171,57 @@ public:
   dcSource(const std::vector<XMLElement> &elements);
 
 private:
-  std::vector<UDBElement>
-  getAuthor1(const std::vector<XMLElement> &elements);
+  enum DCElement
+  {
+    DCTitle,
+    DCCreator,
+    DCSubject,
+    DCDate,
+    DCDescription,
+    DCLanguage,
+    DCPublisher,
+    DCIdentifier,
+    DCSource,
+    DCRoleMeta,
+    DCElementCount
+  };
+
+  typedef std::array<std::vector<XMLElement *>, DCElementCount> DCFound;
+
+  typedef std::array<std::vector<const XMLNode *>, DCElementCount>
+      DCNodeFound;
 
-  std::vector<UDBElement>
-  getAuthor2(const std::vector<XMLElement> &elements);
+  void
+  dcCollect(const std::vector<XMLElement> &elements, DCFound &found);
 
-  std::vector<UDBElement>
-  getTranslator1(const std::vector<XMLElement> &elements);
+  void
+  dcCollect(const XMLNode *node, DCNodeFound &found);
 
-  std::vector<UDBElement>
-  getTranslator2(const std::vector<XMLElement> &elements);
+  DCElement
+  dcElement(const std::string_view &name);
 
   void
-  normalizeString(std::string &str);
+  dcRoles(const DCFound &found, const std::string &role,
+          const BaseID::ID &element_id, const bool &first_only,
+          std::vector<UDBElement> &result);
+
+  void
+  dcRoles(const DCNodeFound &found, const std::string &role,
+          const BaseID::ID &element_id, const bool &first_only,
+          std::vector<UDBElement> &result);
+
+  void
+  appendContent(const std::vector<XMLElement *> &source,
+                const BaseID::ID &element_id, const bool &first_only,
+                std::vector<UDBElement> &result);
 
-  XMLParserCPP *xml_parser;
+  void
+  appendContent(const std::vector<const XMLNode *> &source,
+                const BaseID::ID &element_id, const bool &first_only,
+                std::vector<UDBElement> &result);
+
+  void
+  normalizeString(std::string &str);
 
   BaseID bid;
 };
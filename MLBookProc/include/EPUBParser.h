@@ -19,6 +19,7 @@
 #include <BaseID.h>
 #include <DublinCoreParser.h>
 #include <LibArchive.h>
+#include <LibArchiveZipReader.h>
 #include <MLBookProc.h>
 #include <UDBase.h>
 
@@ -59,10 +60,7 @@ public:
 
 private:
   std::string
-  epubGetRootFileAddress(
-      const std::string &book_content,
-      const std::vector<std::tuple<std::string, uint64_t, uint64_t>>
-          &filenames);
+  epubGetRootFileAddress(const LibArchiveZipReader &zip);
 
   void
   epubParseRootFile(const std::string &root_file_content, UDBElement &result);
@@ -71,11 +69,9 @@ private:
   epubCoverAddress1(const std::vector<XMLElement> &root_file_content);
 
   std::string
-  epubCoverAddress2(
-      const std::vector<XMLElement> &root_file_content,
-      const std::string &root_file_path, const std::string &book_content,
-      const std::vector<std::tuple<std::string, uint64_t, uint64_t>>
-          &filenames);
+  epubCoverAddress2(const std::vector<XMLElement> &root_file_content,
+                    const std::string &root_file_path,
+                    const LibArchiveZipReader &zip);
 
   bool
   imageSearchFunction1(const XMLElement &el);
@@ -39,7 +39,8 @@ public:
   virtual ~FB2Parser();
 
   /*!
-   * Parses fb2 book.
+   * Parses fb2 book. Only `description` block is parsed if it can be found
+   * (whole book is parsed otherwise).
    *
    * \param file_content fb2 file content.
    * \return BaseID::Book object.
@@ -48,7 +49,9 @@ public:
   parseBook(const std::string &file_content);
 
   /*!
-   * Obtains extra information about book (see BookInfo).
+   * Obtains extra information about book (see BookInfo). Only `description`
+   * block is parsed if it can be found. Cover image is searched by its id
+   * from the end of file, so other binaries and body are not parsed.
    *
    * \param book_content fb2 file content.
    * \return UDBase object containing found information.
@@ -60,9 +63,18 @@ private:
   UDBElement
   fb2GetInfoForBase(const std::vector<XMLElement> &book_xml);
 
+  UDBElement
+  fb2GetInfoForBase(const XMLDocument &book_xml);
+
+  bool
+  fb2Description(const std::string &book, std::string &result);
+
   std::vector<UDBElement>
   fb2Author(const std::vector<XMLElement *> &author);
 
+  std::vector<UDBElement>
+  fb2Author(const std::vector<const XMLNode *> &author);
+
   void
   fb2AuthorBookInfo(const std::vector<XMLElement *> &author,
                     std::vector<UDBElement> &result);
@@ -71,6 +83,10 @@ private:
   fb2Series(const std::vector<XMLElement *> &sequence,
             std::vector<UDBElement> &book_subelements);
 
+  void
+  fb2Series(const std::vector<const XMLNode *> &sequence,
+            std::vector<UDBElement> &book_subelements);
+
   void
   fb2Annotation(const std::vector<XMLElement *> &annotation,
                 std::string &result);
@@ -82,10 +98,29 @@ private:
   fb2CoverGetImage(const std::vector<XMLElement> &book_xml,
                    const std::vector<XMLElement *> &image, UDBElement &result);
 
+  void
+  fb2CoverLazy(const std::string &book_content,
+               const std::vector<XMLElement> &description, UDBElement &result);
+
+  std::string
+  fb2CoverName(const std::vector<XMLElement *> &image);
+
+  void
+  fb2Binary(const std::string &book_content, const std::string &id,
+            std::string &result);
+
+  void
+  fb2TextCover(const std::string &book_content,
+               std::vector<XMLElement> &result);
+
   void
   getResult(const std::vector<XMLElement *> &elements,
             std::vector<UDBElement> &result, const BaseID::ID &element_id);
 
+  void
+  getResult(const std::vector<const XMLNode *> &nodes,
+            std::vector<UDBElement> &result, const BaseID::ID &element_id);
+
   void
   normalizeString(std::string &str);
 
@@ -17,6 +17,7 @@
 #define LIBARCHIVE_H
 
 #include <LibArchiveFileData.h>
+#include <LibArchiveZipWriter.h>
 #include <MLBookProc.h>
 #include <archive.h>
 #include <filesystem>
@@ -174,7 +175,8 @@ public:
                                  const std::filesystem::path &directory);
 
   /*!
-   * Unpacks file to buffer.
+   * Unpacks file to buffer. If archive is a file, LibArchiveCache is used
+   * for solid archives (see unpackFilesToBuffers()).
    *
    * \note This method can throw std::exception in case of errors.
    *
@@ -233,6 +235,44 @@ public:
   unpackZipBufferFileToBuffer(const std::string &buffer,
                               const std::string &filename);
 
+  /*!
+   * Unpacks several files from archive to buffers in single pass through
+   * archive. Files are searched in LibArchiveCache first (see
+   * MLBookProc::getArchiveCache()). For solid archives (7z, rar) requested
+   * entries and entries following them (up to quarter of cache size) are
+   * added to cache, so consequent requests to neighbouring files do not
+   * decompress solid block again.
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param archive_path Path to archive.
+   * \param filenames Names of files in archive.
+   * \return Vector of buffers containing unpacked files. Order of buffers
+   * corresponds to \a filenames order. Buffers of not found files are empty.
+   */
+  std::vector<std::string>
+  unpackFilesToBuffers(const std::filesystem::path &archive_path,
+                       const std::vector<std::string> &filenames);
+
+  /*!
+   * Unpacks several files from several archives. Requests are grouped by
+   * archive, so every archive is opened and read only once. Entries of zip
+   * archives are unpacked in order of their offsets (obtained from central
+   * directory), other archives are read in single pass. Different archives
+   * are processed in parallel.
+   *
+   * \param requests Vector of tuples: first element - path to archive, second
+   * - name of file in archive, third - directory file to be unpacked to (see
+   * unpackFileToDirectory()).
+   * \return Vector of absolute paths to unpacked files. Order of paths
+   * corresponds to \a requests order. Paths of files, which have not been
+   * unpacked, are empty.
+   */
+  std::vector<std::filesystem::path>
+  unpackFilesToDirectories(
+      const std::vector<std::tuple<std::filesystem::path, std::string,
+                                   std::filesystem::path>> &requests);
+
   /*!
    * Writes file to archive.
    *
@@ -273,7 +313,63 @@ public:
                              const std::filesystem::perms &perms,
                              const bool &overwrite_existing);
 
+  /*!
+   * Removes files from zip archive in place. Only data placed after first
+   * removed file is moved, central directory is rewritten and file is
+   * truncated. If \a keep_holes is \a true, only central directory is
+   * rewritten (removed files data stays in archive, but is not accessible).
+   *
+   * \note This method throws std::invalid_argument if archive is not a zip
+   * archive, is zip64 or multi-disk archive or cannot be read. Archive is not
+   * modified in this case. Other std::exception means, that modification has
+   * been started and archive can be damaged.
+   *
+   * \warning Archive will be corrupted if operation is interrupted.
+   *
+   * \param archive_path Path to archive.
+   * \param filenames Names of files to be removed.
+   * \param keep_holes If \a true, removed files data will not be reclaimed.
+   * \return Number of entries left in archive.
+   */
+  size_t
+  removeFromZip(const std::filesystem::path &archive_path,
+                const std::vector<std::string> &filenames,
+                const bool &keep_holes = false);
+
+  /*!
+   * Sets number of threads to be used for compression by writeToArchive()
+   * and writeBufferObjectToArchive(). Zip entries are compressed in parallel
+   * (one entry per thread) and written to archive in their original order.
+   * For xz and zstd filters <a href="https://libarchive.org/">libarchive</a>
+   * `threads` option is set. Other formats and filters are compressed in
+   * single thread anyway.
+   *
+   * \note In parallel zip mode entries are kept in memory while being
+   * compressed, so memory consumption grows with threads number.
+   *
+   * \param threads Number of threads. \a 1 (default) disables parallel
+   * compression, \a 0 means number of hardware threads.
+   */
+  void
+  setCompressionThreads(const unsigned &threads);
+
 protected:
+  /*!
+   * Obtains entries from zip archive central directory only. Unlike
+   * listFilesInZip(), this method does not fall back to sequential archive
+   * reading.
+   *
+   * \note This method throws std::exception if central directory cannot be
+   * found or parsed.
+   *
+   * \param archive_path Path to archive.
+   * \param result Vector of obtained entries (see listFilesInZip()).
+   */
+  void
+  listFilesInZipCentralDirectory(
+      const std::filesystem::path &archive_path,
+      std::vector<std::tuple<std::string, uint64_t, uint64_t>> &result);
+
   /*!
    * Initializes archive for reading.
    *
@@ -392,7 +488,8 @@ protected:
                 size_t length);
 
   /*!
-   * Unpacks file to directory.
+   * Unpacks file to directory. If archive is a file, LibArchiveCache is used
+   * for solid archives (see unpackFilesToBuffers()).
    *
    * \note This method can throw std::exception in case of errors.
    *
@@ -407,7 +504,8 @@ protected:
                     const std::filesystem::path &directory);
 
   /*!
-   * Unpacks file to buffer.
+   * Unpacks file to buffer. If archive is a file, LibArchiveCache is used
+   * for solid archives (see unpackFilesToBuffers()).
    *
    * \note This method can throw std::exception in case of errors.
    *
@@ -454,10 +552,13 @@ protected:
    * \param path Path to file to be packed.
    * \param name_in_archive Name of file in archive.
    * \param perms File permissions.
+   * \param zip_writer Smart pointer to LibArchiveZipWriter object. If it is
+   * not null, file is passed to it instead of \a a.
    */
   void
   writeFile(std::shared_ptr<archive> a, const std::filesystem::path &path,
-            std::string name_in_archive, const std::filesystem::perms &perms);
+            std::string name_in_archive, const std::filesystem::perms &perms,
+            std::shared_ptr<LibArchiveZipWriter> zip_writer = nullptr);
 
   /*!
    * Writes buffer to archive.
@@ -473,6 +574,38 @@ protected:
                        std::shared_ptr<archive_entry> e,
                        const std::string &buf);
 
+  /*!
+   * Applies number of compression threads (see setCompressionThreads()) to
+   * archive opened for writing.
+   *
+   * \param a Smart pointer to `archive` object (see <a
+   * href="https://libarchive.org/">libarchive</a> documentation for details).
+   * Format and filters must be set already. In parallel zip mode \a a is
+   * reset and must not be opened.
+   * \param fd Smart pointer to LibArchiveFileData object of archive.
+   * \return Smart pointer to LibArchiveZipWriter object in parallel zip mode,
+   * otherwise null.
+   */
+  std::shared_ptr<LibArchiveZipWriter>
+  setWriteThreads(std::shared_ptr<archive> &a,
+                  const std::shared_ptr<LibArchiveFileData> &fd);
+
+  /*!
+   * Writes entry to archive or passes it to \a zip_writer (if it is not
+   * null).
+   *
+   * \param a Smart pointer to `archive` object (see <a
+   * href="https://libarchive.org/">libarchive</a> documentation for details).
+   * \param zip_writer Smart pointer to LibArchiveZipWriter object.
+   * \param e Smart pointer to `archive_entry` object (see <a
+   * href="https://libarchive.org/">libarchive</a> documentation for details).
+   * \param buf Entry content. Can be moved out.
+   */
+  void
+  writeEntry(std::shared_ptr<archive> a,
+             std::shared_ptr<LibArchiveZipWriter> zip_writer,
+             std::shared_ptr<archive_entry> e, std::string &buf);
+
   /*!
    * Returns permissions read from entry.
    *
@@ -499,6 +632,34 @@ protected:
   std::shared_ptr<MLBookProc> mlbp;
 
 private:
+  bool
+  solidFormat(const std::shared_ptr<archive> &a);
+
+  bool
+  cacheEntry(const std::shared_ptr<archive> &a,
+             const std::shared_ptr<archive_entry> &e,
+             const std::filesystem::path &archive_path,
+             const std::shared_ptr<LibArchiveCache> &cache,
+             size_t &read_ahead);
+
+  void
+  unpackGroupToDirectories(
+      const std::filesystem::path &archive_path,
+      std::vector<std::tuple<std::string, std::filesystem::path, size_t>>
+          &group,
+      std::vector<std::filesystem::path> &result);
+
+  void
+  unpackZipGroupToDirectories(
+      const std::filesystem::path &archive_path,
+      std::vector<std::tuple<std::string, std::filesystem::path, size_t>>
+          &group,
+      std::vector<std::filesystem::path> &result);
+
+  void
+  bufferToFile(const std::string &buf, const std::filesystem::path &file_path,
+               const std::filesystem::perms &perms);
+
   void
   getCentralDirectory(std::shared_ptr<std::istream> f, const uint64_t &fsz,
                       std::string &result);
@@ -530,6 +691,8 @@ private:
   std::string
   crc32Sum(unsigned char *buf, size_t len);
 
+  unsigned compression_threads = 1;
+
   int ZIP64_UNCOMPRESSED = 1;
   int ZIP64_COMPRESSED = 2;
   int ZIP64_OFFSET = 4;
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARCHIVECACHE_H
+#define LIBARCHIVECACHE_H
+
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/*!
+ * \brief The LibArchiveCache class
+ *
+ * Auxiliary class for LibArchive. Keeps decoded content of recently unpacked
+ * entries of solid archives (7z, rar), so subsequent requests to the same or
+ * neighbouring entries do not decompress solid block from its beginning
+ * again. Total size of cached content is limited (64 MiB by default). Least
+ * recently used entries are removed first. Cached entries are invalidated if
+ * archive file size or modification time have been changed.
+ *
+ * \warning Do not create this class objects yourself. If you need this class
+ * object, it should be obtained from MLBookProc::getArchiveCache method only.
+ */
+class LibArchiveCache
+{
+public:
+  LibArchiveCache();
+
+  virtual ~LibArchiveCache();
+
+  LibArchiveCache(const LibArchiveCache &) = delete;
+
+  LibArchiveCache(LibArchiveCache &&) = delete;
+
+  /*!
+   * Sets maximum size of cached content. If new size is less than current
+   * size of cached content, least recently used entries will be removed.
+   *
+   * \param cache_size Size in bytes. \a 0 disables caching.
+   */
+  void
+  setCacheSize(const size_t &cache_size);
+
+  /*!
+   * Returns maximum size of cached content.
+   *
+   * \return Size in bytes.
+   */
+  size_t
+  getCacheSize();
+
+  /*!
+   * Searches entry in cache.
+   *
+   * \param archive_path Path to archive.
+   * \param entry_name Name of entry in archive.
+   * \param result Entry content (if found).
+   * \param perms Entry permissions (if found).
+   * \return \a true if entry has been found, \a false otherwise.
+   */
+  bool
+  getEntry(const std::filesystem::path &archive_path,
+           const std::string &entry_name, std::string &result,
+           std::filesystem::perms &perms);
+
+  /*!
+   * Adds entry to cache. Entries bigger than 1/4 of cache size are ignored.
+   *
+   * \param archive_path Path to archive.
+   * \param entry_name Name of entry in archive.
+   * \param content Entry content.
+   * \param perms Entry permissions.
+   */
+  void
+  addEntry(const std::filesystem::path &archive_path,
+           const std::string &entry_name, const std::string &content,
+           const std::filesystem::perms &perms);
+
+  /*!
+   * Checks if entry of given size can be cached.
+   *
+   * \param entry_size Size of entry content.
+   * \return \a true if entry can be cached, \a false otherwise.
+   */
+  bool
+  acceptable(const size_t &entry_size);
+
+  /*!
+   * Removes all entries of given archive from cache. Call this method if
+   * archive has been changed.
+   *
+   * \param archive_path Path to archive.
+   */
+  void
+  removeArchive(const std::filesystem::path &archive_path);
+
+  /*!
+   * Removes all entries from cache.
+   */
+  void
+  clear();
+
+private:
+  bool
+  archiveStamp(const std::filesystem::path &archive_path,
+               std::filesystem::file_time_type &mtime, uintmax_t &fsz);
+
+  void
+  shrink();
+
+  // archive path, archive modification time, archive size, entry name, entry
+  // content, entry permissions
+  std::list<std::tuple<std::filesystem::path, std::filesystem::file_time_type,
+                       uintmax_t, std::string, std::string,
+                       std::filesystem::perms>>
+      cache;
+  std::mutex cache_mtx;
+
+  size_t cache_size = 67108864;
+  size_t current_size = 0;
+};
+
+#endif // LIBARCHIVECACHE_H
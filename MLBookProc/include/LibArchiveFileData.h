@@ -19,6 +19,8 @@
 #include <filesystem>
 #include <istream>
 #include <memory>
+#include <string>
+#include <string_view>
 
 /*!
  * \brief The LibArchiveFileData class
@@ -52,7 +54,8 @@ public:
   std::ios_base::openmode open_mode;
 
   /*!
-   * Path to file to be opened. If empty, #source_buffer will be used instead.
+   * Path to file to be opened. If empty, #source_buffer (or #source_view)
+   * will be used instead.
    * Set it in case of need.
    */
   std::filesystem::path path;
@@ -62,6 +65,13 @@ public:
    */
   std::string source_buffer;
 
+  /*!
+   * Buffer to be read without copying. If not empty, it is used instead of
+   * #path and #source_buffer. Buffer must stay alive while this object is in
+   * use. Set it in case of need.
+   */
+  std::string_view source_view;
+
   /*!
    * Pointer to inner buffer.
    *
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARCHIVEMEMORYSTREAM_H
+#define LIBARCHIVEMEMORYSTREAM_H
+
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+
+/*!
+ * \brief The LibArchiveMemoryStream class
+ *
+ * Auxiliary class for LibArchive. Read-only stream over memory buffer. Unlike
+ * std::stringstream it does not copy buffer, so buffer must stay alive while
+ * stream is in use.
+ *
+ * \warning Do not create this class objects yourself. It is used by
+ * LibArchive for buffered archives (see LibArchiveFileData::source_view).
+ */
+class LibArchiveMemoryStream : public std::iostream
+{
+public:
+  /*!
+   * \brief LibArchiveMemoryStream constructor.
+   * \param data Pointer to buffer.
+   * \param size Buffer size.
+   */
+  LibArchiveMemoryStream(const char *data, const size_t &size);
+
+  virtual ~LibArchiveMemoryStream();
+
+private:
+  class MemoryBuffer : public std::streambuf
+  {
+  public:
+    MemoryBuffer(const char *data, const size_t &size);
+
+  protected:
+    pos_type
+    seekoff(off_type off, std::ios_base::seekdir dir,
+            std::ios_base::openmode which) override;
+
+    pos_type
+    seekpos(pos_type pos, std::ios_base::openmode which) override;
+  };
+
+  MemoryBuffer memory_buffer;
+};
+
+#endif // LIBARCHIVEMEMORYSTREAM_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARCHIVEZIPREADER_H
+#define LIBARCHIVEZIPREADER_H
+
+#include <LibArchive.h>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * \brief The LibArchiveZipReader class
+ *
+ * Auxiliary class for zip based book formats (epub, odt). Lists zip archive
+ * placed in memory once and gives access to its entries by name, so every
+ * entry is unpacked directly from its offset without listing archive again.
+ * Archive buffer is not copied.
+ *
+ * \warning Archive buffer and LibArchive object must stay alive while this
+ * object is in use.
+ */
+class LibArchiveZipReader
+{
+public:
+  /*!
+   * \brief LibArchiveZipReader constructor.
+   *
+   * Lists archive entries (see LibArchive::listFilesInZipBuffer()).
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param arch Pointer to LibArchive object.
+   * \param buffer Archive content.
+   */
+  LibArchiveZipReader(LibArchive *arch, const std::string &buffer);
+
+  /*!
+   * \brief Returns archive entries.
+   * \return Vector of entries (see LibArchive::listFilesInZipBuffer()).
+   */
+  const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &
+  files() const;
+
+  /*!
+   * \brief Checks if entry is present in archive.
+   * \param filename Entry name.
+   * \return \a true if entry has been found.
+   */
+  bool
+  contains(const std::string &filename) const;
+
+  /*!
+   * \brief Unpacks entry to buffer.
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param filename Entry name.
+   * \return Entry content. Empty if entry has not been found.
+   */
+  std::string
+  unpack(const std::string &filename) const;
+
+private:
+  LibArchive *arch;
+  const std::string *buffer;
+
+  std::vector<std::tuple<std::string, uint64_t, uint64_t>> file_list;
+  std::unordered_map<std::string, size_t> file_index;
+};
+
+#endif // LIBARCHIVEZIPREADER_H
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARCHIVEZIPWRITER_H
+#define LIBARCHIVEZIPWRITER_H
+
+#include <LibArchiveFileData.h>
+#include <archive.h>
+#include <archive_entry.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*!
+ * \brief The LibArchiveZipWriter class
+ *
+ * Auxiliary class for LibArchive. Compresses zip entries in parallel and
+ * writes them to output archive in the order they have been added. Each
+ * entry is compressed by <a href="https://libarchive.org/">libarchive</a> to
+ * its own single-entry zip in memory, then local parts of such zips are
+ * appended to output file and their central directory records are merged
+ * (zip64 records are written if needed).
+ *
+ * \warning Do not create this class objects yourself. It is used by
+ * LibArchive::writeToArchive() and LibArchive::writeBufferObjectToArchive()
+ * if LibArchive::setCompressionThreads() has been called.
+ */
+class LibArchiveZipWriter
+{
+public:
+  /*!
+   * \brief LibArchiveZipWriter constructor.
+   *
+   * Opens output file.
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param fd Smart pointer to LibArchiveFileData object. Output file is
+   * opened in LibArchiveFileData::f stream, so resetting it closes file.
+   * \param threads Number of compressing threads.
+   */
+  LibArchiveZipWriter(const std::shared_ptr<LibArchiveFileData> &fd,
+                      const unsigned &threads);
+
+  virtual ~LibArchiveZipWriter();
+
+  /*!
+   * \brief Adds entry to archive.
+   *
+   * Entry is copied, so it can be reused by caller. Entries are compressed
+   * in batches, so actual writing can be postponed until next calls or
+   * finish() call.
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param e Smart pointer to `archive_entry` object (see <a
+   * href="https://libarchive.org/">libarchive</a> documentation for details).
+   * \param buf Entry content (moved in to avoid copying).
+   */
+  void
+  addEntry(const std::shared_ptr<archive_entry> &e, std::string buf);
+
+  /*!
+   * \brief Writes remaining entries and central directory.
+   *
+   * Output stream is closed after this method call.
+   *
+   * \note This method can throw std::exception in case of errors.
+   */
+  void
+  finish();
+
+private:
+  void
+  flush();
+
+  std::string
+  compressEntry(const std::shared_ptr<archive_entry> &e,
+                const std::string &buf);
+
+  void
+  appendEntry(const std::string &zip);
+
+  static la_ssize_t
+  writeCallback(archive *a, void *client_data, const void *buffer,
+                size_t length);
+
+  std::shared_ptr<LibArchiveFileData> fd;
+
+  unsigned threads;
+
+  std::vector<std::tuple<std::shared_ptr<archive_entry>, std::string>> batch;
+
+  size_t batch_size = 0;
+
+  std::string central_directory;
+
+  uint64_t entries = 0;
+
+  uint64_t offset = 0;
+};
+
+#endif // LIBARCHIVEZIPWRITER_H
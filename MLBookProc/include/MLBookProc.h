@@ -17,6 +17,7 @@
 #define MLBOOKPROC_H
 
 #include <DJVUContext.h>
+#include <LibArchiveCache.h>
 #include <filesystem>
 #include <gcrypt.h>
 #include <gpg-error.h>
@@ -76,6 +77,24 @@ public:
 
   virtual ~MLBookProc();
 
+  /*!
+   * File formats recognized by fileFormat() and contentFormat().
+   */
+  enum FileFormat
+  {
+    Unknown,
+    FB2,
+    FBD,
+    EPUB,
+    PDF,
+    DJVU,
+    ODT,
+    TXT,
+    MD,
+    ZIP,
+    Archive
+  };
+
   /*!
    * Creates MLBookProc object and retunrs smart pointer to it.
    * \return Smart pointer to MLBookProc object.
@@ -132,6 +151,56 @@ public:
   std::vector<std::string>
   getSupportedArchivesTypesPacking();
 
+  /*!
+   * Detects file format by file name extension (case insensitive). This
+   * method only examines string, it does not access file system, so it is
+   * cheap enough to be called for every file or archive entry.
+   *
+   * Extension `.zip` gives MLBookProc::ZIP, other supported archive types
+   * give MLBookProc::Archive.
+   *
+   * \param file_name UTF-8 file name or path to file (including paths inside
+   * archives).
+   * \return File format or MLBookProc::Unknown.
+   */
+  FileFormat
+  fileFormat(const std::string &file_name);
+
+  /*!
+   * Same as fileFormat(const std::string &), but for filesystem paths. Does
+   * not access file system.
+   *
+   * \param p Path to file.
+   * \return File format or MLBookProc::Unknown.
+   */
+  FileFormat
+  fileFormat(const std::filesystem::path &p);
+
+  /*!
+   * Detects file format by content
+   * <a href="https://en.wikipedia.org/wiki/List_of_file_signatures">magic
+   * numbers</a>. Recognizes MLBookProc::PDF, MLBookProc::DJVU,
+   * MLBookProc::FB2 (XML with `FictionBook` root element), MLBookProc::EPUB
+   * and MLBookProc::ODT (by `mimetype` entry), MLBookProc::ZIP and
+   * MLBookProc::Archive (gzip, bzip2, xz, 7z, rar, tar and cpio). Plain text
+   * files are not recognized.
+   *
+   * \param buf Beginning of file content (4 KiB are enough).
+   * \return File format or MLBookProc::Unknown.
+   */
+  FileFormat
+  contentFormat(const std::string &buf);
+
+  /*!
+   * Reads beginning of file and calls contentFormat().
+   *
+   * \param p Path to file.
+   * \return File format or MLBookProc::Unknown (also in case file cannot be
+   * read).
+   */
+  FileFormat
+  fileContentFormat(const std::filesystem::path &p);
+
   /*!
    * Checks if given file is supported.
    *
@@ -197,26 +266,40 @@ public:
   timeToDate(const time_t &tt);
 
   /*!
-   * Creates DJVUContext object.
+   * Leases DJVUContext object from internal pool (new object is created if
+   * pool is empty). Object returns to pool when last smart pointer copy is
+   * destroyed. Do not share returned object between threads.
    *
    * \return Smart pointer to DJVUContext object.
    */
   std::shared_ptr<DJVUContext>
   getDJVUContext();
 
+  /*!
+   * Returns LibArchiveCache object, shared by all LibArchive objects (see
+   * LibArchiveCache for details).
+   *
+   * \return Smart pointer to LibArchiveCache object.
+   */
+  std::shared_ptr<LibArchiveCache>
+  getArchiveCache();
+
 private:
   MLBookProc();
 
   void
   activation();
 
-  static void
-  djvuMessageCallback(ddjvu_context_t *context, void *closure);
+  void
+  releaseDJVUContext(DJVUContext *ctx);
 
   std::vector<std::string> supported_types;
 
-  std::weak_ptr<DJVUContext> djvu_contex;
+  std::vector<std::unique_ptr<DJVUContext>> djvu_contexts;
   std::mutex djvu_context_mtx;
+
+  std::shared_ptr<LibArchiveCache> archive_cache;
+  std::mutex archive_cache_mtx;
 };
 
 #endif // MLBOOKPROC_H
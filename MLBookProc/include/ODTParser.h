@@ -19,6 +19,7 @@
 #include <BaseID.h>
 #include <DublinCoreParser.h>
 #include <LibArchive.h>
+#include <LibArchiveZipReader.h>
 #include <MLBookProc.h>
 #include <UDBase.h>
 #include <XMLParserCPP.h>
@@ -67,7 +67,6 @@ private:
 
   LibArchive *la = nullptr;
 
-  std::vector<std::string> supported_archives;
 
   std::filesystem::path unpack_dir;
 
@@ -19,6 +19,14 @@
 #include <BaseID.h>
 #include <MLBookProc.h>
 #include <UDBase.h>
+#include <filesystem>
+#include <memory>
+
+namespace poppler
+{
+class document;
+class page;
+}
 
 /*!
  * \brief The PDFParser class
@@ -46,6 +54,20 @@ public:
   UDBElement
   parseBook(const std::string &book_content);
 
+  /*!
+   * Parses pdf file directly from disk.
+   *
+   * Unlike parseBook(const std::string &), this method does not read whole
+   * file into memory: poppler reads only the objects it needs.
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param file_path Path to pdf file.
+   * \return BaseID::Book object.
+   */
+  UDBElement
+  parseBook(const std::filesystem::path &file_path);
+
   /*!
    * Gets extra information from file.
    *
@@ -57,6 +79,18 @@ public:
   UDBase
   getBookInfo(const std::string &book_content);
 
+  /*!
+   * Gets extra information from pdf file directly from disk (see
+   * parseBook(const std::filesystem::path &)).
+   *
+   * \note This method can throw std::exception in case of errors.
+   *
+   * \param file_path Path to pdf file.
+   * \return UDBase object containing found information.
+   */
+  UDBase
+  getBookInfo(const std::filesystem::path &file_path);
+
   /*!
    * Sets DPI (see BookInfo::setDPI).
    *
@@ -67,6 +101,23 @@ public:
   setDPI(const double &horizontal_dpi = double(72.0),
          const double &vertical_dpi = double(72.0));
 
+  /*!
+   * Sets maximum cover size (see BookInfo::setCoverSize).
+   *
+   * \param max_width Maximum cover width in pixels.
+   * \param max_height Maximum cover height in pixels.
+   */
+  void
+  setCoverSize(const int &max_width = 0, const int &max_height = 0);
+
+  /*!
+   * Enables or disables cover rendering (see BookInfo::setCoverRendering).
+   *
+   * \param render If \a false, first page is not rendered.
+   */
+  void
+  setCoverRendering(const bool &render);
+
   /*!
    * Returns horizontal DPI.
    *
@@ -84,6 +135,18 @@ public:
   getVerticalDPI();
 
 private:
+  std::unique_ptr<poppler::document>
+  loadFile(const std::filesystem::path &file_path);
+
+  UDBElement
+  parseDocument(poppler::document *doc);
+
+  UDBase
+  documentInfo(poppler::document *doc);
+
+  void
+  coverDPI(poppler::page *page, double &h_dpi, double &v_dpi);
+
   void
   normalizeString(std::string &str);
 
@@ -92,6 +155,11 @@ private:
   double horizontal_dpi = 72.0;
   double vertical_dpi = 72.0;
 
+  int max_cover_width = 0;
+  int max_cover_height = 0;
+
+  bool render_cover = true;
+
   BaseID bid;
 };
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef PARSERPOOL_H
+#define PARSERPOOL_H
+
+#include <EPUBParser.h>
+#include <FB2Parser.h>
+#include <MLBookProc.h>
+#include <ODTParser.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * \brief The ParserPool class
+ *
+ * Auxiliary class keeping FB2Parser, EPUBParser and ODTParser objects for
+ * reuse. Parsers do not keep any document state between calls, so one object
+ * can parse any number of books, and per-book construction of parsers and
+ * their helper objects is avoided. Used by CreateCollection and
+ * ArchiveParser.
+ *
+ * Each parser is leased to one thread at a time and returns to pool when last
+ * copy of smart pointer is destroyed.
+ *
+ * \warning ParserPool object must outlive all leased parsers.
+ */
+class ParserPool
+{
+public:
+  /*!
+   * \brief ParserPool constructor.
+   * \param mlbp Smart pointer to MLBookProc object.
+   */
+  ParserPool(const std::shared_ptr<MLBookProc> &mlbp);
+
+  ParserPool(const ParserPool &) = delete;
+
+  ParserPool(ParserPool &&) = delete;
+
+  ParserPool &
+  operator=(const ParserPool &)
+      = delete;
+
+  ParserPool &
+  operator=(ParserPool &&)
+      = delete;
+
+  virtual ~ParserPool();
+
+  /*!
+   * Leases FB2Parser object (new object is created if pool is empty).
+   *
+   * \return Smart pointer to FB2Parser object.
+   */
+  std::shared_ptr<FB2Parser>
+  getFB2Parser();
+
+  /*!
+   * Leases EPUBParser object (new object is created if pool is empty).
+   *
+   * \return Smart pointer to EPUBParser object.
+   */
+  std::shared_ptr<EPUBParser>
+  getEPUBParser();
+
+  /*!
+   * Leases ODTParser object (new object is created if pool is empty).
+   *
+   * \return Smart pointer to ODTParser object.
+   */
+  std::shared_ptr<ODTParser>
+  getODTParser();
+
+private:
+  template <typename T>
+  std::shared_ptr<T>
+  lease(std::vector<std::unique_ptr<T>> &pool);
+
+  std::shared_ptr<MLBookProc> mlbp;
+
+  std::vector<std::unique_ptr<FB2Parser>> fb2_parsers;
+  std::vector<std::unique_ptr<EPUBParser>> epub_parsers;
+  std::vector<std::unique_ptr<ODTParser>> odt_parsers;
+  std::mutex pool_mtx;
+};
+
+#endif // PARSERPOOL_H
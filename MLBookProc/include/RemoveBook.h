@@ -48,6 +48,32 @@ public:
   removeBook(const std::filesystem::path &base_path,
              const UDBElement &book_search_result);
 
+  /*!
+   * Same as removeBook(), but removes several books. Books packed in the same
+   * zip archive are removed by single archive rewrite, collection is
+   * refreshed once.
+   *
+   * \note This method can throw std::exception in case of errors.
+   * \warning If book is packed in rar archive, whole archive will be removed.
+   *
+   * \param base_path Path to collection database file.
+   * \param book_search_results Vector of BookID::BookSearchResult objects.
+   */
+  void
+  removeBooks(const std::filesystem::path &base_path,
+              const std::vector<UDBElement> &book_search_results);
+
+  /*!
+   * Sets zip archives compaction mode. Books are removed from zip archives in
+   * place (see LibArchive::removeFromZip()). If \a keep_holes is \a true,
+   * only central directory of archive is rewritten and removed books data
+   * stays in archive file. Default value is \a false.
+   *
+   * \param keep_holes Compaction mode.
+   */
+  void
+  setKeepHoles(const bool &keep_holes);
+
   /*!
    * If book was packed in archive, archive file will be reparsed after
    * removing. This callback idicates parsing progress if set.
@@ -55,11 +81,16 @@ public:
   std::function<void(double processed, double total)> signal_parsing_progress;
 
 private:
+  void
+  removeBookFiles(const std::vector<UDBElement> &book_search_results);
+
   size_t
   removeFromArchive(const UDBElement &path,
                     const std::filesystem::path &archive_path);
 
   BaseID bid;
+
+  bool keep_holes = false;
 };
 
 #endif // REMOVEBOOK_H
@@ -48,15 +48,56 @@ public:
   /*!
    * Gets extra info from file.
    *
+   * Only first bytes of file are read (see setPreviewLimit()). Text encoding
+   * is detected on them and converted prefix is used as book cover.
+   *
    * \param file_path Path to file.
    * \return UDBase containing information.
    */
   UDBase
   getBookInfo(const std::filesystem::path &file_path);
 
+  /*!
+   * Same as getBookInfo(const std::filesystem::path&), but for book content
+   * already loaded to memory (for example, unpacked from archive). Result
+   * does not contain BaseID::EbookDate.
+   *
+   * \param book_content Book file content.
+   * \param format MLBookProc::TXT or MLBookProc::MD.
+   * \return UDBase containing information.
+   */
+  UDBase
+  getBookInfo(const std::string &book_content,
+              const MLBookProc::FileFormat &format);
+
+  /*!
+   * \brief Sets maximum size of text to be read for book cover.
+   *
+   * Prefix is cut at last line break (or at last complete UTF-8 character),
+   * so actual size can be smaller. Default value is 32768 bytes.
+   * \param preview_limit Maximum size in bytes.
+   */
+  void
+  setPreviewLimit(const size_t &preview_limit);
+
 private:
+  void
+  coverPage(UDBase &result, const std::string &prefix,
+            const MLBookProc::FileFormat &format);
+
+  std::string
+  readPrefix(const std::filesystem::path &file_path);
+
+  void
+  trimPrefix(std::string &prefix);
+
+  std::string
+  textEncoding(const std::string &prefix);
+
   std::shared_ptr<MLBookProc> mlbp;
 
+  size_t preview_limit = 32768;
+
   BaseID bid;
 };
 
@@ -31,12 +31,18 @@ ArchiveParser::ArchiveParser(
     const std::shared_ptr<std::vector<std::tuple<unsigned int, bool>>>
         &thread_v,
     const std::shared_ptr<std::mutex> &thread_v_mtx,
-    const std::shared_ptr<std::condition_variable> &thread_v_var)
+    const std::shared_ptr<std::condition_variable> &thread_v_var,
+    const std::shared_ptr<ParserPool> &parser_pool)
     : LibArchive(mlbp)
 {
   this->thread_v = thread_v;
   this->thread_v_mtx = thread_v_mtx;
   this->thread_v_var = thread_v_var;
+  this->parser_pool = parser_pool;
+  if(!this->parser_pool)
+    {
+      this->parser_pool = std::make_shared<ParserPool>(mlbp);
+    }
   cancel.store(false, std::memory_order_relaxed);
 }
 
@@ -53,6 +59,23 @@ ArchiveParser::~ArchiveParser()
 std::vector<UDBElement>
 ArchiveParser::parseArchive(const std::filesystem::path &file_path)
 {
+  if(mlbp->fileFormat(file_path) == MLBookProc::ZIP)
+    {
+      if(parseZipParallel(file_path))
+        {
+          std::unique_lock<std::mutex> ullock(thr_num_mtx);
+          thr_num_var.wait(ullock,
+                           [this]
+                             {
+                               return thr_num <= 0;
+                             });
+
+          fbdProcessing();
+
+          return result;
+        }
+    }
+
   std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
   fd->path = file_path;
   fd->open_mode = std::ios_base::in | std::ios_base::binary;
@@ -145,15 +168,293 @@ void
 ArchiveParser::stopAll()
 {
   cancel.store(true, std::memory_order_relaxed);
-  if(arch_proc)
+  std::lock_guard<std::mutex> lglock(arch_proc_mtx);
+  for(auto it = arch_proc.begin(); it != arch_proc.end(); it++)
     {
-      arch_proc->stopAll();
+      (*it)->stopAll();
     }
 }
 
+bool
+ArchiveParser::parseZipParallel(const std::filesystem::path &file_path)
+{
+  std::vector<std::tuple<std::string, uint64_t, uint64_t>> list;
+  try
+    {
+      listFilesInZipCentralDirectory(file_path, list);
+    }
+  catch(std::exception &er)
+    {
+      std::osyncstream(std::cout) << "ArchiveParser::parseZipParallel: \""
+                                  << er.what() << "\"" << std::endl;
+      return false;
+    }
+  if(list.size() < 2)
+    {
+      return false;
+    }
+
+  std::sort(list.begin(), list.end(),
+            [](const std::tuple<std::string, uint64_t, uint64_t> &el1,
+               const std::tuple<std::string, uint64_t, uint64_t> &el2)
+              {
+                return std::get<2>(el1) < std::get<2>(el2);
+              });
+
+  std::vector<std::vector<std::tuple<unsigned, bool>>::iterator> free_thr;
+  std::unique_lock<std::mutex> ullock(*thread_v_mtx);
+  for(auto it = thread_v->begin(); it != thread_v->end(); it++)
+    {
+      if(std::get<1>(*it) && free_thr.size() < list.size())
+        {
+          free_thr.push_back(it);
+        }
+    }
+  if(free_thr.size() < 2)
+    {
+      return false;
+    }
+
+  uint64_t total = 0;
+  for(auto it = list.begin(); it != list.end(); it++)
+    {
+      total += std::get<1>(*it);
+    }
+  uint64_t range_sz = total / free_thr.size() + 1;
+
+  std::vector<std::vector<std::tuple<std::string, uint64_t, uint64_t>>> ranges;
+  ranges.resize(1);
+  uint64_t accum = 0;
+  for(auto it = list.begin(); it != list.end(); it++)
+    {
+      if(accum >= range_sz && ranges.size() < free_thr.size())
+        {
+          ranges.resize(ranges.size() + 1);
+          accum = 0;
+        }
+      ranges.rbegin()->emplace_back(*it);
+      accum += std::get<1>(*it);
+    }
+
+  for(size_t i = 0; i < ranges.size(); i++)
+    {
+      std::vector<std::tuple<unsigned, bool>>::iterator it_thr = free_thr[i];
+      std::get<1>(*it_thr) = false;
+      std::vector<std::tuple<std::string, uint64_t, uint64_t>> range
+          = std::move(ranges[i]);
+      {
+        std::lock_guard<std::mutex> lglock(thr_num_mtx);
+        thr_num++;
+      }
+      std::thread thr(
+          [this, file_path, range, it_thr]
+            {
+              parseZipRange(file_path, range);
+
+              std::scoped_lock lock(*thread_v_mtx, thr_num_mtx);
+              thr_num--;
+              std::get<1>(*it_thr) = true;
+              thr_num_var.notify_one();
+              thread_v_var->notify_one();
+            });
+#ifdef __linux
+      cpu_set_t cpu;
+      CPU_ZERO(&cpu);
+      CPU_SET(std::get<0>(*it_thr), &cpu);
+      int er = pthread_setaffinity_np(thr.native_handle(), sizeof(cpu_set_t),
+                                      &cpu);
+      if(er)
+        {
+          std::osyncstream(std::cout)
+              << "ArchiveParser::parseZipParallel: \"" << std::strerror(er)
+              << "\"" << std::endl;
+        }
+#elif defined(_WIN32)
+      GROUP_AFFINITY gaf{};
+      gaf.Group = std::get<0>(*it_thr) / (sizeof(KAFFINITY) * CHAR_BIT);
+      gaf.Mask = (1 << std::get<0>(*it_thr) % (sizeof(KAFFINITY) * CHAR_BIT));
+      HANDLE handle = pthread_gethandle(thr.native_handle());
+      if(handle != nullptr)
+        {
+          if(SetThreadGroupAffinity(handle, &gaf, nullptr) == 0)
+            {
+              std::osyncstream(std::cout)
+                  << "ArchiveParser::parseZipParallel "
+                     "SetThreadAffinityMask: \""
+                  << std::strerror(GetLastError()) << "\"" << std::endl;
+            }
+        }
+      else
+        {
+          std::osyncstream(std::cout)
+              << "ArchiveParser::parseZipParallel: handle is null!"
+              << std::endl;
+        }
+#endif
+      thr.detach();
+    }
+
+  return true;
+}
+
+void
+ArchiveParser::parseZipRange(
+    const std::filesystem::path &file_path,
+    const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &range)
+{
+  size_t i = 0;
+  while(i < range.size())
+    {
+      if(cancel.load(std::memory_order_relaxed))
+        {
+          break;
+        }
+      // Each stream is opened on local header of entry without seek
+      // callback, so libarchive reads following entries sequentially from
+      // this point. On errors stream is reopened from the next entry. If local
+      // entry is not listed in central directory (e.g. it has been removed
+      // with keep_holes or it is garbage), stream is reopened on offset of
+      // expected entry.
+      std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
+      fd->path = file_path;
+      fd->open_mode = std::ios_base::in | std::ios_base::binary;
+      fd->start_offset = static_cast<size_t>(std::get<2>(range[i]));
+
+      std::shared_ptr<archive> a;
+      int er;
+      try
+        {
+          a = initForReading(fd);
+          er = archive_read_open2(
+              a.get(), fd.get(), &LibArchive::openCallBack,
+              &LibArchive::readCallBack, &LibArchive::skipCallback,
+              &LibArchive::closeCallback);
+          if(er != ARCHIVE_OK)
+            {
+              archiveError(a, "ArchiveParser::parseZipRange:");
+            }
+        }
+      catch(std::exception &er)
+        {
+          std::osyncstream(std::cout)
+              << er.what() << " " << std::get<0>(range[i]) << std::endl;
+          i++;
+          continue;
+        }
+
+      int retry_count = 0;
+      bool stream_ok = true;
+      bool first_header = true;
+      while(stream_ok && i < range.size() && retry_count < 3)
+        {
+          if(cancel.load(std::memory_order_relaxed))
+            {
+              break;
+            }
+
+          std::shared_ptr<archive_entry> e(archive_entry_new(),
+                                           [](archive_entry *e)
+                                             {
+                                               archive_entry_free(e);
+                                             });
+          er = archive_read_next_header2(a.get(), e.get());
+          switch(er)
+            {
+            case ARCHIVE_WARN:
+              {
+                const char *str = archive_error_string(a.get());
+                std::string err;
+                if(str)
+                  {
+                    err = std::string("ArchiveParser::parseZipRange: \"")
+                          + str + "\"";
+                  }
+                else
+                  {
+                    err = std::string("ArchiveParser::parseZipRange: ")
+                          + std::strerror(archive_errno(a.get()));
+                  }
+                std::osyncstream(std::cout) << err << std::endl;
+              }
+            case ARCHIVE_OK:
+              {
+                retry_count = 0;
+                // First header is read from offset of expected entry, so
+                // name mismatch can be caused by name encoding only.
+                if(!first_header && !sameEntry(e, std::get<0>(range[i])))
+                  {
+                    stream_ok = false;
+                    break;
+                  }
+                first_header = false;
+                // Entries with data descriptor do not have size in local
+                // header, so emptiness is checked by compressed size from
+                // central directory instead.
+                bool size_set = archive_entry_size_is_set(e.get());
+                if(!size_set && std::get<1>(range[i]) == 0)
+                  {
+                    i++;
+                    break;
+                  }
+                try
+                  {
+                    parseEntry(a, e, size_set);
+                  }
+                catch(std::exception &er)
+                  {
+                    std::osyncstream(std::cout)
+                        << "ArchiveParser::parseZipRange: \"" << er.what()
+                        << "\" " << std::get<0>(range[i]) << std::endl;
+                    stream_ok = false;
+                  }
+                i++;
+                break;
+              }
+            case ARCHIVE_RETRY:
+              {
+                retry_count++;
+                break;
+              }
+            default:
+              {
+                std::osyncstream(std::cout)
+                    << "ArchiveParser::parseZipRange: cannot read entry "
+                    << std::get<0>(range[i]) << std::endl;
+                stream_ok = false;
+                i++;
+                break;
+              }
+            }
+        }
+      if(retry_count >= 3)
+        {
+          i++;
+        }
+    }
+}
+
+bool
+ArchiveParser::sameEntry(const std::shared_ptr<archive_entry> &e,
+                         const std::string &name)
+{
+  const char *val = archive_entry_pathname_utf8(e.get());
+  if(val != nullptr && name == val)
+    {
+      return true;
+    }
+  val = archive_entry_pathname(e.get());
+  if(val != nullptr && name == val)
+    {
+      return true;
+    }
+
+  return false;
+}
+
 void
 ArchiveParser::parseEntry(std::shared_ptr<archive> a,
-                          std::shared_ptr<archive_entry> e)
+                          std::shared_ptr<archive_entry> e,
+                          const bool &check_size)
 {
   const char *val = archive_entry_pathname_utf8(e.get());
   if(val == nullptr)
@@ -161,26 +462,28 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
       return void();
     }
   std::string arch_file_path(val);
-  la_int64_t sz = 0;
-  if(archive_entry_size_is_set(e.get()))
+  if(check_size)
     {
-      sz = archive_entry_size(e.get());
-      if(sz < 0)
+      la_int64_t sz = 0;
+      if(archive_entry_size_is_set(e.get()))
         {
-          sz = 0;
+          sz = archive_entry_size(e.get());
+          if(sz < 0)
+            {
+              sz = 0;
+            }
+        }
+      if(sz == 0)
+        {
+          return void();
         }
-    }
-  if(sz == 0)
-    {
-      return void();
     }
 
-  std::string ext = mlbp->getExtension(arch_file_path);
-  ext = mlbp->stringToLower(ext);
+  MLBookProc::FileFormat format = mlbp->fileFormat(arch_file_path);
   std::unique_ptr<std::thread> thr;
   std::unique_lock<std::mutex> ullock(*thread_v_mtx, std::defer_lock);
   std::vector<std::tuple<unsigned, bool>>::iterator it_thr;
-  if(ext == ".fb2")
+  if(format == MLBookProc::FB2)
     {
       std::string buf = unpackEntryToBuffer(a, e);
       ullock.lock();
@@ -215,7 +518,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
           result.emplace_back(book);
         }
     }
-  else if(ext == ".epub")
+  else if(format == MLBookProc::EPUB)
     {
       std::string buf = unpackEntryToBuffer(a, e);
 
@@ -252,7 +555,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
           result.emplace_back(book);
         }
     }
-  else if(ext == ".pdf")
+  else if(format == MLBookProc::PDF)
     {
       std::string buf = unpackEntryToBuffer(a, e);
 
@@ -288,7 +591,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
           result.emplace_back(book);
         }
     }
-  else if(ext == ".djvu")
+  else if(format == MLBookProc::DJVU)
     {
       std::string buf = unpackEntryToBuffer(a, e);
 
@@ -325,7 +628,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
           result.emplace_back(book);
         }
     }
-  else if(ext == ".odt")
+  else if(format == MLBookProc::ODT)
     {
       std::string buf = unpackEntryToBuffer(a, e);
 
@@ -361,7 +664,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
           result.emplace_back(book);
         }
     }
-  else if(ext == ".txt" || ext == ".md")
+  else if(format == MLBookProc::TXT || format == MLBookProc::MD)
     {
       UDBElement book;
       bid.setId(book, BaseID::Book);
@@ -393,7 +696,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
       std::lock_guard<std::mutex> lglock(thr_num_mtx);
       result.emplace_back(book);
     }
-  else if(ext == ".fbd")
+  else if(format == MLBookProc::FBD)
     {
       std::string buf = unpackEntryToBuffer(a, e);
 
@@ -431,7 +734,7 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
     }
   else
     {
-      if(mlbp->ifSupportedFile(arch_file_path))
+      if(format == MLBookProc::ZIP || format == MLBookProc::Archive)
         {
           std::filesystem::path tmp_dir
               = mlbp->tempDirPath() / mlbp->randomFileName();
@@ -455,22 +758,37 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
             }
 
           std::vector<UDBElement> books;
-          arch_proc = std::shared_ptr<ArchiveParser>(
-              new ArchiveParser(mlbp, thread_v, thread_v_mtx, thread_v_var),
+          std::shared_ptr<ArchiveParser> nested_proc(
+              new ArchiveParser(mlbp, thread_v, thread_v_mtx, thread_v_var,
+                                parser_pool),
               [tmp_dir](ArchiveParser *parser)
                 {
                   delete parser;
                   std::filesystem::remove_all(tmp_dir);
                 });
+          {
+            std::lock_guard<std::mutex> lglock(arch_proc_mtx);
+            arch_proc.push_back(nested_proc);
+          }
+          if(cancel.load(std::memory_order_relaxed))
+            {
+              nested_proc->stopAll();
+            }
           try
             {
-              books = arch_proc->parseArchive(arch_path);
+              books = nested_proc->parseArchive(arch_path);
             }
           catch(std::exception &er)
             {
               std::osyncstream(std::cout) << "ArchiveParser::parseEntry: \""
                                           << er.what() << "\"" << std::endl;
             }
+          {
+            std::lock_guard<std::mutex> lglock(arch_proc_mtx);
+            arch_proc.erase(
+                std::remove(arch_proc.begin(), arch_proc.end(), nested_proc),
+                arch_proc.end());
+          }
 
           for(auto it = books.begin(); it != books.end(); it++)
             {
@@ -496,7 +814,60 @@ ArchiveParser::parseEntry(std::shared_ptr<archive> a,
         }
       else
         {
-          unsupported.push_back(arch_file_path);
+          bool parsed = false;
+          std::filesystem::path entry_path = std::u8string(
+              arch_file_path.begin(), arch_file_path.end());
+          if(!entry_path.has_extension())
+            {
+              // Entries without extension are recognized by content.
+              std::string buf = unpackEntryToBuffer(a, e);
+              FileType ft = FileType::FB2;
+              parsed = true;
+              switch(mlbp->contentFormat(buf))
+                {
+                case MLBookProc::FB2:
+                  {
+                    ft = FileType::FB2;
+                    break;
+                  }
+                case MLBookProc::EPUB:
+                  {
+                    ft = FileType::EPUB;
+                    break;
+                  }
+                case MLBookProc::PDF:
+                  {
+                    ft = FileType::PDF;
+                    break;
+                  }
+                case MLBookProc::DJVU:
+                  {
+                    ft = FileType::DJVU;
+                    break;
+                  }
+                case MLBookProc::ODT:
+                  {
+                    ft = FileType::ODT;
+                    break;
+                  }
+                default:
+                  {
+                    parsed = false;
+                    break;
+                  }
+                }
+              if(parsed)
+                {
+                  UDBElement book = bufferParse(buf, arch_file_path, e, ft);
+                  std::lock_guard<std::mutex> lglock(thr_num_mtx);
+                  result.emplace_back(book);
+                }
+            }
+          if(!parsed)
+            {
+              std::lock_guard<std::mutex> lglock(thr_num_mtx);
+              unsupported.push_back(arch_file_path);
+            }
         }
     }
   if(it_thr != thread_v->end() && ullock && thr)
@@ -552,14 +923,15 @@ ArchiveParser::bufferParse(const std::string &buf,
         {
         case FileType::FB2:
           {
-            FB2Parser parser(mlbp);
-            book = parser.parseBook(buf);
+            std::shared_ptr<FB2Parser> parser = parser_pool->getFB2Parser();
+            book = parser->parseBook(buf);
             break;
           }
         case FileType::EPUB:
           {
-            EPUBParser parser(mlbp);
-            book = parser.parseBook(buf);
+            std::shared_ptr<EPUBParser> parser
+                = parser_pool->getEPUBParser();
+            book = parser->parseBook(buf);
             break;
           }
         case FileType::PDF:
@@ -576,8 +948,8 @@ ArchiveParser::bufferParse(const std::string &buf,
           }
         case FileType::ODT:
           {
-            ODTParser parser(mlbp);
-            book = parser.parseBook(buf);
+            std::shared_ptr<ODTParser> parser = parser_pool->getODTParser();
+            book = parser->parseBook(buf);
             break;
           }
         default:
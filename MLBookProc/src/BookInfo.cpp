@@ -68,6 +68,19 @@ BookInfo::setDPI(const double &horizontal_dpi, const double &vertical_dpi)
   this->vertical_dpi = vertical_dpi;
 }
 
+void
+BookInfo::setCoverSize(const int &max_width, const int &max_height)
+{
+  max_cover_width = max_width;
+  max_cover_height = max_height;
+}
+
+void
+BookInfo::setCoverRendering(const bool &render)
+{
+  render_cover = render;
+}
+
 double
 BookInfo::getHorizontalDPI()
 {
@@ -85,35 +98,13 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
 {
   UDBase result;
 
-  std::string ext = mlbp->getExtension(p);
-  ext = mlbp->stringToLower(ext);
-  if(ext == ".fb2" || ext == ".fbd")
+  MLBookProc::FileFormat format = mlbp->fileFormat(p);
+  if(format == MLBookProc::Unknown)
     {
-      std::fstream f;
-      f.open(p, std::ios_base::in | std::ios_base::binary);
-      if(!f.is_open())
-        {
-          return result;
-        }
-      f.seekg(0, std::ios_base::end);
-      std::string buf;
-      buf.resize(static_cast<size_t>(f.tellg()));
-      f.seekg(0, std::ios_base::beg);
-      f.read(buf.data(), buf.size());
-      f.close();
-
-      FB2Parser parser(mlbp);
-      try
-        {
-          result = parser.getBookInfo(buf);
-        }
-      catch(std::exception &er)
-        {
-          std::cout << "BookInfo::bookInfo: \"" << er.what() << "\""
-                    << std::endl;
-        }
+      format = mlbp->fileContentFormat(p);
     }
-  else if(ext == ".epub")
+  if(format == MLBookProc::FB2 || format == MLBookProc::FBD
+     || format == MLBookProc::EPUB || format == MLBookProc::ODT)
     {
       std::fstream f;
       f.open(p, std::ios_base::in | std::ios_base::binary);
@@ -128,37 +119,19 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
       f.read(buf.data(), buf.size());
       f.close();
 
-      EPUBParser parser(mlbp);
-      try
-        {
-          result = parser.getBookInfo(buf);
-        }
-      catch(std::exception &er)
-        {
-          std::cout << "BookInfo::bookInfo: \"" << er.what() << "\""
-                    << std::endl;
-        }
+      std::u8string u8str = p.filename().u8string();
+      result = bufferInfo(buf, std::string(u8str.begin(), u8str.end()),
+                          UDBElement());
     }
-  else if(ext == ".pdf")
+  else if(format == MLBookProc::PDF)
     {
-      std::fstream f;
-      f.open(p, std::ios_base::in | std::ios_base::binary);
-      if(!f.is_open())
-        {
-          return result;
-        }
-      f.seekg(0, std::ios_base::end);
-      std::string buf;
-      buf.resize(static_cast<size_t>(f.tellg()));
-      f.seekg(0, std::ios_base::beg);
-      f.read(buf.data(), buf.size());
-      f.close();
-
       PDFParser parser(mlbp);
       parser.setDPI(horizontal_dpi, vertical_dpi);
+      parser.setCoverSize(max_cover_width, max_cover_height);
+      parser.setCoverRendering(render_cover);
       try
         {
-          result = parser.getBookInfo(buf);
+          result = parser.getBookInfo(p);
         }
       catch(std::exception &er)
         {
@@ -166,51 +139,14 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
                     << std::endl;
         }
     }
-  else if(ext == ".djvu")
+  else if(format == MLBookProc::DJVU)
     {
-      std::fstream f;
-      f.open(p, std::ios_base::in | std::ios_base::binary);
-      if(!f.is_open())
-        {
-          return result;
-        }
-      f.seekg(0, std::ios_base::end);
-      std::string buf;
-      buf.resize(static_cast<size_t>(f.tellg()));
-      f.seekg(0, std::ios_base::beg);
-      f.read(buf.data(), buf.size());
-      f.close();
-
       DJVUParser parser(mlbp);
+      parser.setCoverSize(max_cover_width, max_cover_height);
+      parser.setCoverRendering(render_cover);
       try
         {
-          result = parser.getBookInfo(buf);
-        }
-      catch(std::exception &er)
-        {
-          std::cout << "BookInfo::bookInfo: \"" << er.what() << "\""
-                    << std::endl;
-        }
-    }
-  else if(ext == ".odt")
-    {
-      std::fstream f;
-      f.open(p, std::ios_base::in | std::ios_base::binary);
-      if(!f.is_open())
-        {
-          return result;
-        }
-      f.seekg(0, std::ios_base::end);
-      std::string buf;
-      buf.resize(static_cast<size_t>(f.tellg()));
-      f.seekg(0, std::ios_base::beg);
-      f.read(buf.data(), buf.size());
-      f.close();
-
-      ODTParser parser(mlbp);
-      try
-        {
-          result = parser.getBookInfo(buf);
+          result = parser.getBookInfo(p);
         }
       catch(std::exception &er)
         {
@@ -218,7 +154,7 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
                     << std::endl;
         }
     }
-  else if(ext == ".txt" || ext == ".md")
+  else if(format == MLBookProc::TXT || format == MLBookProc::MD)
     {
       TXTParser parser(mlbp);
       try
@@ -231,7 +167,7 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
                     << std::endl;
         }
     }
-  else
+  else if(format == MLBookProc::ZIP || format == MLBookProc::Archive)
     {
       BaseID::ID id = bid.getId(path);
       switch(id)
@@ -261,127 +197,164 @@ BookInfo::bookInfo(const std::filesystem::path &p, const UDBElement &path)
                 return result;
               }
 
-            std::unique_ptr<std::filesystem::path,
-                            std::function<void(std::filesystem::path *)>>
-                tmp_dir(new std::filesystem::path(mlbp->tempDirPath()
-                                                  / mlbp->randomFileName()),
-                        [](std::filesystem::path *p)
-                          {
-                            std::filesystem::remove_all(*p);
-                            delete p;
-                          });
-
-            LibArchive la(mlbp);
-            std::filesystem::path res_p;
-            std::vector<UDBElement>::const_iterator it_fbd = std::find_if(
-                it_p->subelements.begin(), it_p->subelements.end(),
-                [this](const UDBElement &el)
-                  {
-                    return bid.getId(el) == BaseID::FBDPath;
-                  });
-            if(it_fbd != it_p->subelements.end())
-              {
-                if(ext == ".zip")
-                  {
-                    res_p = la.unpackZipFileToDirectory(p, it_fbd->content,
-                                                        *tmp_dir);
-                  }
-                else
-                  {
-                    res_p = la.unpackFileToDirectory(p, it_fbd->content,
-                                                     *tmp_dir);
-                  }
-                result = bookInfo(res_p, UDBElement());
-                return result;
-              }
-
-            if(ext == ".zip")
-              {
-                res_p
-                    = la.unpackZipFileToDirectory(p, it_p->content, *tmp_dir);
-              }
-            else
-              {
-                res_p = la.unpackFileToDirectory(p, it_p->content, *tmp_dir);
-              }
-
-            UDBElement path_l;
-            std::vector<UDBElement>::const_iterator it_p2 = std::find_if(
-                it_p->subelements.begin(), it_p->subelements.end(),
-                [this](const UDBElement &el)
-                  {
-                    return bid.getId(el) == BaseID::PathInFile;
-                  });
-            if(it_p2 != it_p->subelements.end())
-              {
-                path_l = *it_p2;
-              }
-            result = bookInfo(res_p, path_l);
+            result = archiveInfo(p, std::string(), format, *it_p);
             break;
           }
         case BaseID::PathInFile:
           {
-            std::unique_ptr<std::filesystem::path,
-                            std::function<void(std::filesystem::path *)>>
-                tmp_dir(new std::filesystem::path(mlbp->tempDirPath()
-                                                  / mlbp->randomFileName()),
-                        [](std::filesystem::path *p)
-                          {
-                            std::filesystem::remove_all(*p);
-                            delete p;
-                          });
+            result = archiveInfo(p, std::string(), format, path);
+            break;
+          }
+        default:
+          break;
+        }
+    }
 
-            LibArchive la(mlbp);
-            std::filesystem::path res_p;
-            std::vector<UDBElement>::const_iterator it_fbd = std::find_if(
-                path.subelements.begin(), path.subelements.end(),
-                [this](const UDBElement &el)
-                  {
-                    return bid.getId(el) == BaseID::FBDPath;
-                  });
-            if(it_fbd != path.subelements.end())
-              {
-                if(ext == ".zip")
-                  {
-                    res_p = la.unpackZipFileToDirectory(p, it_fbd->content,
-                                                        *tmp_dir);
-                  }
-                else
-                  {
-                    res_p = la.unpackFileToDirectory(p, it_fbd->content,
-                                                     *tmp_dir);
-                  }
-                result = bookInfo(res_p, UDBElement());
-                return result;
-              }
+  return result;
+}
 
-            if(ext == ".zip")
-              {
-                res_p = la.unpackZipFileToDirectory(p, path.content, *tmp_dir);
-              }
-            else
-              {
-                res_p = la.unpackFileToDirectory(p, path.content, *tmp_dir);
-              }
+UDBase
+BookInfo::archiveInfo(const std::filesystem::path &archive_path,
+                      const std::string &archive_buffer,
+                      const MLBookProc::FileFormat &format,
+                      const UDBElement &path)
+{
+  std::string file_name = path.content;
+  UDBElement path_l;
+  std::vector<UDBElement>::const_iterator it_fbd
+      = std::find_if(path.subelements.begin(), path.subelements.end(),
+                     [this](const UDBElement &el)
+                       {
+                         return bid.getId(el) == BaseID::FBDPath;
+                       });
+  if(it_fbd != path.subelements.end())
+    {
+      file_name = it_fbd->content;
+    }
+  else
+    {
+      std::vector<UDBElement>::const_iterator it_p = std::find_if(
+          path.subelements.begin(), path.subelements.end(),
+          [this](const UDBElement &el)
+            {
+              return bid.getId(el) == BaseID::PathInFile;
+            });
+      if(it_p != path.subelements.end())
+        {
+          path_l = *it_p;
+        }
+    }
 
-            UDBElement path_l;
-            std::vector<UDBElement>::const_iterator it_p2 = std::find_if(
-                path.subelements.begin(), path.subelements.end(),
-                [this](const UDBElement &el)
-                  {
-                    return bid.getId(el) == BaseID::PathInFile;
-                  });
-            if(it_p2 != path.subelements.end())
+  LibArchive la(mlbp);
+  std::string buf;
+  if(archive_buffer.empty())
+    {
+      if(format == MLBookProc::ZIP)
+        {
+          buf = la.unpackZipFileToBuffer(archive_path, file_name);
+        }
+      else
+        {
+          buf = la.unpackFileToBuffer(archive_path, file_name);
+        }
+    }
+  else
+    {
+      if(format == MLBookProc::ZIP)
+        {
+          buf = la.unpackZipBufferFileToBuffer(archive_buffer, file_name);
+        }
+      else
+        {
+          buf = la.unpackBufferFileToBuffer(archive_buffer, file_name);
+        }
+    }
+
+  return bufferInfo(buf, file_name, path_l);
+}
+
+UDBase
+BookInfo::bufferInfo(const std::string &buf, const std::string &file_name,
+                     const UDBElement &path)
+{
+  UDBase result;
+
+  if(buf.empty())
+    {
+      return result;
+    }
+
+  MLBookProc::FileFormat format = mlbp->fileFormat(file_name);
+  if(format == MLBookProc::Unknown)
+    {
+      format = mlbp->contentFormat(buf);
+    }
+  try
+    {
+      switch(format)
+        {
+        case MLBookProc::FB2:
+        case MLBookProc::FBD:
+          {
+            FB2Parser parser(mlbp);
+            result = parser.getBookInfo(buf);
+            break;
+          }
+        case MLBookProc::EPUB:
+          {
+            EPUBParser parser(mlbp);
+            result = parser.getBookInfo(buf);
+            break;
+          }
+        case MLBookProc::ODT:
+          {
+            ODTParser parser(mlbp);
+            result = parser.getBookInfo(buf);
+            break;
+          }
+        case MLBookProc::PDF:
+          {
+            PDFParser parser(mlbp);
+            parser.setDPI(horizontal_dpi, vertical_dpi);
+            parser.setCoverSize(max_cover_width, max_cover_height);
+            parser.setCoverRendering(render_cover);
+            result = parser.getBookInfo(buf);
+            break;
+          }
+        case MLBookProc::DJVU:
+          {
+            DJVUParser parser(mlbp);
+            parser.setCoverSize(max_cover_width, max_cover_height);
+            parser.setCoverRendering(render_cover);
+            result = parser.getBookInfo(buf);
+            break;
+          }
+        case MLBookProc::TXT:
+        case MLBookProc::MD:
+          {
+            TXTParser parser(mlbp);
+            result = parser.getBookInfo(buf, format);
+            break;
+          }
+        case MLBookProc::ZIP:
+        case MLBookProc::Archive:
+          {
+            if(!path.id.empty())
               {
-                path_l = *it_p2;
+                result = archiveInfo(std::filesystem::path(), buf, format,
+                                     path);
               }
-            result = bookInfo(res_p, path_l);
             break;
           }
         default:
           break;
         }
     }
+  catch(std::exception &er)
+    {
+      std::cout << "BookInfo::bufferInfo: \"" << er.what() << "\""
+                << std::endl;
+    }
 
   return result;
 }
@@ -37,6 +37,7 @@ CreateCollection::CreateCollection(const std::shared_ptr<MLBookProc> &mlbp,
                                    const int &threads_num)
 {
   this->mlbp = mlbp;
+  parser_pool = std::make_shared<ParserPool>(mlbp);
 
   threads_v = std::make_shared<std::vector<std::tuple<unsigned, bool>>>();
   threads_v_mtx = std::make_shared<std::mutex>();
@@ -259,7 +260,9 @@ CreateCollection::filesCollecting(
                     ec))
               {
                 std::filesystem::path p = dir_it.path();
-                if(std::filesystem::is_symlink(p))
+                // Directory entry caches file type, so checks below do not
+                // need extra system calls for regular files.
+                if(dir_it.is_symlink())
                   {
                     std::error_code l_ec;
                     std::filesystem::path resolved
@@ -288,14 +291,18 @@ CreateCollection::filesCollecting(
                         dir.subelements.emplace_back(symlink);
                       }
                   }
-                else if(mlbp->ifSupportedFile(p))
+                else if(!dir_it.is_directory())
                   {
-                    UDBElement file;
-                    bid.setId(file, BaseID::File);
                     u8str = p.u8string();
-                    file.content = std::string(u8str.begin(), u8str.end());
+                    std::string file_path(u8str.begin(), u8str.end());
+                    if(mlbp->ifSupportedFile(file_path))
+                      {
+                        UDBElement file;
+                        bid.setId(file, BaseID::File);
+                        file.content = file_path;
 
-                    dir.subelements.emplace_back(file);
+                        dir.subelements.emplace_back(file);
+                      }
                   }
               }
 
@@ -628,38 +635,47 @@ CreateCollection::fileParsing(UDBElement *file)
 {
   std::filesystem::path p
       = std::u8string(file->content.begin(), file->content.end());
-  std::string ext = mlbp->getExtension(p);
-  ext = mlbp->stringToLower(ext);
 
   std::osyncstream(std::cout) << "Start parsing: " << p << std::endl;
 
-  if(ext == ".fb2")
-    {
-      fb2Parsing(file, p);
-    }
-  else if(ext == ".epub")
-    {
-      epubParsing(file, p);
-    }
-  else if(ext == ".pdf")
-    {
-      pdfParsing(file, p);
-    }
-  else if(ext == ".djvu")
-    {
-      djvuParsing(file, p);
-    }
-  else if(ext == ".odt")
-    {
-      odtParsing(file, p);
-    }
-  else if(ext == ".txt" || ext == ".md")
-    {
-      txtParsing(file, p);
-    }
-  else
-    {
-      archiveParsing(file, p);
+  switch(mlbp->fileFormat(p))
+    {
+    case MLBookProc::FB2:
+      {
+        fb2Parsing(file, p);
+        break;
+      }
+    case MLBookProc::EPUB:
+      {
+        epubParsing(file, p);
+        break;
+      }
+    case MLBookProc::PDF:
+      {
+        pdfParsing(file, p);
+        break;
+      }
+    case MLBookProc::DJVU:
+      {
+        djvuParsing(file, p);
+        break;
+      }
+    case MLBookProc::ODT:
+      {
+        odtParsing(file, p);
+        break;
+      }
+    case MLBookProc::TXT:
+    case MLBookProc::MD:
+      {
+        txtParsing(file, p);
+        break;
+      }
+    default:
+      {
+        archiveParsing(file, p);
+        break;
+      }
     }
 
   std::osyncstream(std::cout) << "Finish parsing: " << p << std::endl;
@@ -840,8 +856,8 @@ CreateCollection::fb2Parsing(UDBElement *file,
 
   try
     {
-      FB2Parser parser(mlbp);
-      book = parser.parseBook(buf);
+      std::shared_ptr<FB2Parser> parser = parser_pool->getFB2Parser();
+      book = parser->parseBook(buf);
     }
   catch(std::exception &er)
     {
@@ -1025,8 +1041,8 @@ CreateCollection::epubParsing(UDBElement *file,
   UDBElement book;
   try
     {
-      EPUBParser parser(mlbp);
-      book = parser.parseBook(buf);
+      std::shared_ptr<EPUBParser> parser = parser_pool->getEPUBParser();
+      book = parser->parseBook(buf);
     }
   catch(std::exception &er)
     {
@@ -1123,19 +1139,10 @@ void
 CreateCollection::pdfParsing(UDBElement *file,
                              const std::filesystem::path &file_path)
 {
-  std::fstream f;
-  f.open(file_path, std::ios_base::in | std::ios_base::binary);
-  if(!f.is_open())
-    {
-      std::osyncstream(std::cout)
-          << "CreateCollection::pdfParsing: cannot open file " << file_path
-          << std::endl;
-
-      return void();
-    }
-  f.seekg(0, std::ios_base::end);
-  std::fpos pos = f.tellg();
-  if(pos <= 0)
+  std::error_code ec;
+  uint64_t fsz
+      = static_cast<uint64_t>(std::filesystem::file_size(file_path, ec));
+  if(ec || fsz == 0)
     {
       std::osyncstream(std::cout)
           << "CreateCollection::pdfParsing: incorrect file size " << file_path
@@ -1144,12 +1151,6 @@ CreateCollection::pdfParsing(UDBElement *file,
       return void();
     }
 
-  std::string buf;
-  buf.resize(static_cast<size_t>(pos));
-  f.seekg(0, std::ios_base::beg);
-  f.read(buf.data(), buf.size());
-  f.close();
-
   std::unique_ptr<std::thread> thr;
   threads_v_mtx->lock();
   auto it_thr = std::find_if(threads_v->begin(), threads_v->end(),
@@ -1161,9 +1162,9 @@ CreateCollection::pdfParsing(UDBElement *file,
     {
       std::get<1>(*it_thr) = false;
       thr = std::unique_ptr<std::thread>(new std::thread(
-          [this, file, file_path, buf, it_thr]
+          [this, file, file_path, it_thr]
             {
-              bufHash(file, file_path, buf);
+              bufHash(file, file_path, std::string());
               std::lock_guard<std::mutex> lglock(*threads_v_mtx);
               std::get<1>(*it_thr) = true;
               threads_v_var->notify_one();
@@ -1206,14 +1207,14 @@ CreateCollection::pdfParsing(UDBElement *file,
   else
     {
       threads_v_mtx->unlock();
-      bufHash(file, file_path, buf);
+      bufHash(file, file_path, std::string());
     }
 
   UDBElement book;
   try
     {
       PDFParser parser(mlbp);
-      book = parser.parseBook(buf);
+      book = parser.parseBook(file_path);
     }
   catch(std::exception &er)
     {
@@ -1283,7 +1284,6 @@ CreateCollection::pdfParsing(UDBElement *file,
       bid.setId(book, BaseID::Book);
     }
 
-  uint64_t fsz = static_cast<uint64_t>(pos);
   ByteOrder bo(fsz);
   bo.getLittle(fsz);
   size_t sz_64 = sizeof(fsz);
@@ -1310,19 +1310,10 @@ void
 CreateCollection::djvuParsing(UDBElement *file,
                               const std::filesystem::path &file_path)
 {
-  std::fstream f;
-  f.open(file_path, std::ios_base::in | std::ios_base::binary);
-  if(!f.is_open())
-    {
-      std::osyncstream(std::cout)
-          << "CreateCollection::djvuParsing: cannot open file " << file_path
-          << std::endl;
-
-      return void();
-    }
-  f.seekg(0, std::ios_base::end);
-  std::fpos pos = f.tellg();
-  if(pos <= 0)
+  std::error_code ec;
+  uint64_t fsz
+      = static_cast<uint64_t>(std::filesystem::file_size(file_path, ec));
+  if(ec || fsz == 0)
     {
       std::osyncstream(std::cout)
           << "CreateCollection::djvuParsing: incorrect file size " << file_path
@@ -1331,12 +1322,6 @@ CreateCollection::djvuParsing(UDBElement *file,
       return void();
     }
 
-  std::string buf;
-  buf.resize(static_cast<size_t>(pos));
-  f.seekg(0, std::ios_base::beg);
-  f.read(buf.data(), buf.size());
-  f.close();
-
   std::unique_ptr<std::thread> thr;
   threads_v_mtx->lock();
   auto it_thr = std::find_if(threads_v->begin(), threads_v->end(),
@@ -1348,9 +1333,9 @@ CreateCollection::djvuParsing(UDBElement *file,
     {
       std::get<1>(*it_thr) = false;
       thr = std::unique_ptr<std::thread>(new std::thread(
-          [this, file, file_path, buf, it_thr]
+          [this, file, file_path, it_thr]
             {
-              bufHash(file, file_path, buf);
+              bufHash(file, file_path, std::string());
               std::lock_guard<std::mutex> lglock(*threads_v_mtx);
               std::get<1>(*it_thr) = true;
               threads_v_var->notify_one();
@@ -1393,14 +1378,14 @@ CreateCollection::djvuParsing(UDBElement *file,
   else
     {
       threads_v_mtx->unlock();
-      bufHash(file, file_path, buf);
+      bufHash(file, file_path, std::string());
     }
 
   UDBElement book;
   try
     {
       DJVUParser parser(mlbp);
-      book = parser.parseBook(buf);
+      book = parser.parseBook(file_path);
     }
   catch(std::exception &er)
     {
@@ -1470,7 +1455,6 @@ CreateCollection::djvuParsing(UDBElement *file,
       bid.setId(book, BaseID::Book);
     }
 
-  uint64_t fsz = static_cast<uint64_t>(pos);
   ByteOrder bo(fsz);
   bo.getLittle(fsz);
   size_t sz_64 = sizeof(fsz);
@@ -1587,8 +1571,8 @@ CreateCollection::odtParsing(UDBElement *file,
 
   try
     {
-      ODTParser parser(mlbp);
-      book = parser.parseBook(buf);
+      std::shared_ptr<ODTParser> parser = parser_pool->getODTParser();
+      book = parser->parseBook(buf);
     }
   catch(std::exception &er)
     {
@@ -1749,7 +1733,8 @@ CreateCollection::archiveParsing(UDBElement *file,
                                  const std::filesystem::path &file_path)
 {
   std::shared_ptr<ArchiveParser> parser(
-      new ArchiveParser(mlbp, threads_v, threads_v_mtx, threads_v_var));
+      new ArchiveParser(mlbp, threads_v, threads_v_mtx, threads_v_var,
+                        parser_pool));
   arch_proc_mtx.lock();
   arch_proc.push_back(parser);
   arch_proc_mtx.unlock();
@@ -1963,7 +1948,14 @@ CreateCollection::bufHash(UDBElement *file,
       bid.setId(el, BaseID::FileHash);
       try
         {
-          el.content = bufferHash(buf);
+          if(buf.empty())
+            {
+              el.content = fileHash(file_path);
+            }
+          else
+            {
+              el.content = bufferHash(buf);
+            }
           file->subelements.emplace_back(el);
         }
       catch(std::exception &er)
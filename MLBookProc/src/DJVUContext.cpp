@@ -19,9 +19,17 @@
 DJVUContext::DJVUContext()
 {
   context = ddjvu_context_create("MLBookProc");
+  ddjvu_message_set_callback(context, &DJVUContext::messageCallback, this);
 }
 
 DJVUContext::~DJVUContext()
 {
   ddjvu_context_release(context);
 }
+
+void
+DJVUContext::messageCallback(ddjvu_context_t *, void *closure)
+{
+  DJVUContext *ctx = reinterpret_cast<DJVUContext *>(closure);
+  ctx->context_var.notify_all();
+}
@@ -31,39 +31,122 @@ DJVUParser::DJVUParser(const std::shared_ptr<MLBookProc> &mlbp)
 UDBElement
 DJVUParser::parseBook(const std::string &book_content)
 {
-  UDBElement result;
-  bid.setId(result, BaseID::Book);
+  std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
+  std::shared_ptr<ddjvu_document_t> doc = createDocument(ctx, book_content);
 
-  UDBElement el;
-  bid.setId(el, BaseID::BookTitle);
-  result.subelements.emplace_back(el);
+  return parseDocument(ctx, doc);
+}
 
-  el = UDBElement();
-  bid.setId(el, BaseID::Date);
-  result.subelements.emplace_back(el);
+UDBElement
+DJVUParser::parseBook(const std::filesystem::path &file_path)
+{
+  std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
+  std::shared_ptr<ddjvu_document_t> doc = openDocument(ctx, file_path);
+
+  return parseDocument(ctx, doc);
+}
+
+UDBase
+DJVUParser::getBookInfo(const std::string &book_content)
+{
+  std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
+  std::shared_ptr<ddjvu_document_t> doc = createDocument(ctx, book_content);
+
+  return documentInfo(ctx, doc);
+}
 
+UDBase
+DJVUParser::getBookInfo(const std::filesystem::path &file_path)
+{
   std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
+  std::shared_ptr<ddjvu_document_t> doc = openDocument(ctx, file_path);
+
+  return documentInfo(ctx, doc);
+}
+
+std::shared_ptr<ddjvu_document_t>
+DJVUParser::createDocument(const std::shared_ptr<DJVUContext> &ctx,
+                           const std::string &book_content)
+{
+  std::shared_ptr<ddjvu_document_t> result;
   if(!ctx.operator bool())
     {
       std::osyncstream(std::cout)
-          << "DJVUParser::parseBook: context object is null!" << std::endl;
+          << "DJVUParser::createDocument: context object is null!"
+          << std::endl;
       return result;
     }
 
-  std::shared_ptr<ddjvu_document_t> doc(
+  result = std::shared_ptr<ddjvu_document_t>(
       ddjvu_document_create(ctx->context, nullptr, false),
       [](ddjvu_document_t *doc)
         {
           ddjvu_document_release(doc);
         });
-  if(!doc.operator bool())
+  if(!result.operator bool())
+    {
+      std::osyncstream(std::cout)
+          << "DJVUParser::createDocument: document object is null!"
+          << std::endl;
+      return result;
+    }
+
+  if(!setBookContentToStream(ctx, result, book_content))
+    {
+      result.reset();
+    }
+
+  return result;
+}
+
+std::shared_ptr<ddjvu_document_t>
+DJVUParser::openDocument(const std::shared_ptr<DJVUContext> &ctx,
+                         const std::filesystem::path &file_path)
+{
+  std::shared_ptr<ddjvu_document_t> result;
+  if(!ctx.operator bool())
     {
       std::osyncstream(std::cout)
-          << "DJVUParser::parseBook: document object is null!" << std::endl;
+          << "DJVUParser::openDocument: context object is null!" << std::endl;
       return result;
     }
 
-  if(!setBookContentToStream(ctx, doc, book_content))
+  // djvulibre reads from file only chunks it needs, so page images are not
+  // loaded unless page is requested.
+  std::u8string u8str = file_path.u8string();
+  std::string fname(u8str.begin(), u8str.end());
+  result = std::shared_ptr<ddjvu_document_t>(
+      ddjvu_document_create_by_filename_utf8(ctx->context, fname.c_str(),
+                                             false),
+      [](ddjvu_document_t *doc)
+        {
+          ddjvu_document_release(doc);
+        });
+  if(!result.operator bool())
+    {
+      std::osyncstream(std::cout)
+          << "DJVUParser::openDocument: document object is null!" << std::endl;
+    }
+
+  return result;
+}
+
+UDBElement
+DJVUParser::parseDocument(const std::shared_ptr<DJVUContext> &ctx,
+                          const std::shared_ptr<ddjvu_document_t> &doc)
+{
+  UDBElement result;
+  bid.setId(result, BaseID::Book);
+
+  UDBElement el;
+  bid.setId(el, BaseID::BookTitle);
+  result.subelements.emplace_back(el);
+
+  el = UDBElement();
+  bid.setId(el, BaseID::Date);
+  result.subelements.emplace_back(el);
+
+  if(!doc.operator bool())
     {
       return result;
     }
@@ -217,32 +300,12 @@ DJVUParser::parseBook(const std::string &book_content)
 }
 
 UDBase
-DJVUParser::getBookInfo(const std::string &book_content)
+DJVUParser::documentInfo(const std::shared_ptr<DJVUContext> &ctx,
+                         const std::shared_ptr<ddjvu_document_t> &doc)
 {
   UDBase result;
 
-  std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
-  if(!ctx.operator bool())
-    {
-      std::osyncstream(std::cout)
-          << "DJVUParser::getBookInfo: context object is null!" << std::endl;
-      return result;
-    }
-
-  std::shared_ptr<ddjvu_document_t> doc(
-      ddjvu_document_create(ctx->context, nullptr, false),
-      [](ddjvu_document_t *doc)
-        {
-          ddjvu_document_release(doc);
-        });
   if(!doc.operator bool())
-    {
-      std::osyncstream(std::cout)
-          << "DJVUParser::getBookInfo: document object is null!" << std::endl;
-      return result;
-    }
-
-  if(!setBookContentToStream(ctx, doc, book_content))
     {
       return result;
     }
@@ -302,6 +365,11 @@ DJVUParser::getBookInfo(const std::string &book_content)
         }
     }
 
+  if(!render_cover)
+    {
+      return result;
+    }
+
   std::shared_ptr<ddjvu_page_t> page = getFirstPage(ctx, doc);
   if(!page.operator bool())
     {
@@ -311,11 +379,23 @@ DJVUParser::getBookInfo(const std::string &book_content)
   int iw = ddjvu_page_get_width(page.get());
   int ih = ddjvu_page_get_height(page.get());
 
+  // Page is rendered directly at reduced size: djvulibre scales it to
+  // page_rect while decoding.
+  double scale = 1.0;
+  if(max_cover_width > 0 && iw > max_cover_width)
+    {
+      scale = static_cast<double>(max_cover_width) / static_cast<double>(iw);
+    }
+  if(max_cover_height > 0 && ih * scale > max_cover_height)
+    {
+      scale = static_cast<double>(max_cover_height) / static_cast<double>(ih);
+    }
+
   ddjvu_rect_t page_rect;
   page_rect.x = 0;
   page_rect.y = 0;
-  page_rect.w = iw;
-  page_rect.h = ih;
+  page_rect.w = std::max(static_cast<unsigned>(iw * scale), 1u);
+  page_rect.h = std::max(static_cast<unsigned>(ih * scale), 1u);
 
   std::unique_ptr<uint32_t, std::function<void(uint32_t *)>> bitmask(
       new uint32_t[4],
@@ -350,7 +430,7 @@ DJVUParser::getBookInfo(const std::string &book_content)
   if(!fmt.operator bool())
     {
       std::osyncstream(std::cout)
-          << "DJVUParser::getBookInfo: format object is null!" << std::endl;
+          << "DJVUParser::documentInfo: format object is null!" << std::endl;
     }
 
   ddjvu_format_set_row_order(fmt.get(), 1);
@@ -392,12 +472,25 @@ DJVUParser::getBookInfo(const std::string &book_content)
   else
     {
       std::osyncstream(std::cout)
-          << "DJVUParser::getBookInfo: DJVU render error" << std::endl;
+          << "DJVUParser::documentInfo: DJVU render error" << std::endl;
     }
 
   return result;
 }
 
+void
+DJVUParser::setCoverSize(const int &max_width, const int &max_height)
+{
+  max_cover_width = max_width;
+  max_cover_height = max_height;
+}
+
+void
+DJVUParser::setCoverRendering(const bool &render)
+{
+  render_cover = render;
+}
+
 bool
 DJVUParser::setBookContentToStream(
     const std::shared_ptr<DJVUContext> &ctx,
@@ -411,40 +504,41 @@ DJVUParser::setBookContentToStream(
       ullock, std::chrono::seconds(5),
       [ctx, doc, &msg]
         {
-          msg = ddjvu_message_peek(ctx->context);
-          if(msg == nullptr)
-            {
-              return false;
-            }
-          if(msg->m_any.document != doc.get())
-            {
-              msg = nullptr;
-              return false;
-            }
-          switch(msg->m_any.tag)
+          while((msg = ddjvu_message_peek(ctx->context)) != nullptr)
             {
-            case DDJVU_ERROR:
-              {
-                std::osyncstream(std::cout)
-                    << "DJVUParser::setBookContentToStream error: "
-                    << msg->m_error.message
-                    << " function: " << msg->m_error.function << std::endl;
-                ddjvu_message_pop(ctx->context);
-                msg = nullptr;
-                break;
-              }
-            case DDJVU_NEWSTREAM:
-              {
-                break;
-              }
-            default:
-              {
-                ddjvu_message_pop(ctx->context);
-                msg = nullptr;
-                return false;
-              }
+              // Context is leased to this thread only (see
+              // MLBookProc::getDJVUContext), so messages of other documents
+              // are leftovers and can be dropped.
+              if(msg->m_any.document != doc.get())
+                {
+                  ddjvu_message_pop(ctx->context);
+                  continue;
+                }
+              switch(msg->m_any.tag)
+                {
+                case DDJVU_ERROR:
+                  {
+                    std::osyncstream(std::cout)
+                        << "DJVUParser::setBookContentToStream error: "
+                        << msg->m_error.message
+                        << " function: " << msg->m_error.function
+                        << std::endl;
+                    ddjvu_message_pop(ctx->context);
+                    msg = nullptr;
+                    return true;
+                  }
+                case DDJVU_NEWSTREAM:
+                  {
+                    return true;
+                  }
+                default:
+                  {
+                    ddjvu_message_pop(ctx->context);
+                    break;
+                  }
+                }
             }
-          return true;
+          return false;
         });
 
   if(msg == nullptr)
@@ -473,41 +567,39 @@ DJVUParser::waitDocumentInfo(const std::shared_ptr<DJVUContext> &ctx,
       ullock, std::chrono::seconds(5),
       [ctx, doc, &msg]
         {
-          msg = ddjvu_message_peek(ctx->context);
-          if(msg == nullptr)
+          while((msg = ddjvu_message_peek(ctx->context)) != nullptr)
             {
-              return false;
-            }
-          if(msg->m_any.document != doc.get())
-            {
-              msg = nullptr;
-              return false;
-            }
-          switch(msg->m_any.tag)
-            {
-            case DDJVU_ERROR:
-              {
-                std::osyncstream(std::cout)
-                    << "DJVUParser::waitDocumentInfo error: "
-                    << msg->m_error.message
-                    << " function: " << msg->m_error.function << std::endl;
-                ddjvu_message_pop(ctx->context);
-                msg = nullptr;
-                break;
-              }
-            case DDJVU_DOCINFO:
-              {
-                ddjvu_message_pop(ctx->context);
-                break;
-              }
-            default:
-              {
-                ddjvu_message_pop(ctx->context);
-                msg = nullptr;
-                return false;
-              }
+              if(msg->m_any.document != doc.get())
+                {
+                  ddjvu_message_pop(ctx->context);
+                  continue;
+                }
+              switch(msg->m_any.tag)
+                {
+                case DDJVU_ERROR:
+                  {
+                    std::osyncstream(std::cout)
+                        << "DJVUParser::waitDocumentInfo error: "
+                        << msg->m_error.message
+                        << " function: " << msg->m_error.function
+                        << std::endl;
+                    ddjvu_message_pop(ctx->context);
+                    msg = nullptr;
+                    return true;
+                  }
+                case DDJVU_DOCINFO:
+                  {
+                    ddjvu_message_pop(ctx->context);
+                    return true;
+                  }
+                default:
+                  {
+                    ddjvu_message_pop(ctx->context);
+                    break;
+                  }
+                }
             }
-          return true;
+          return false;
         });
 
   if(msg == nullptr)
@@ -541,45 +633,39 @@ DJVUParser::getFirstPage(const std::shared_ptr<DJVUContext> &ctx,
       ullock, std::chrono::seconds(5),
       [ctx, doc, &msg, result]
         {
-          msg = ddjvu_message_peek(ctx->context);
-          if(msg == nullptr)
-            {
-              return false;
-            }
-          if(msg->m_any.document != doc.get())
-            {
-              msg = nullptr;
-              return false;
-            }
-          switch(msg->m_any.tag)
+          while((msg = ddjvu_message_peek(ctx->context)) != nullptr)
             {
-            case DDJVU_ERROR:
-              {
-                std::osyncstream(std::cout)
-                    << "DJVUParser::getFirstPage error: "
-                    << msg->m_error.message
-                    << " function: " << msg->m_error.function << std::endl;
-                ddjvu_message_pop(ctx->context);
-                msg = nullptr;
-                break;
-              }
-            default:
-              {
-                if(!ddjvu_page_decoding_done(result.get()))
+              if(msg->m_any.document != doc.get())
+                {
+                  ddjvu_message_pop(ctx->context);
+                  continue;
+                }
+              switch(msg->m_any.tag)
+                {
+                case DDJVU_ERROR:
                   {
+                    std::osyncstream(std::cout)
+                        << "DJVUParser::getFirstPage error: "
+                        << msg->m_error.message
+                        << " function: " << msg->m_error.function
+                        << std::endl;
                     ddjvu_message_pop(ctx->context);
                     msg = nullptr;
-                    return false;
+                    return true;
                   }
-                else
+                default:
                   {
                     ddjvu_message_pop(ctx->context);
+                    if(ddjvu_page_decoding_done(result.get()))
+                      {
+                        return true;
+                      }
+                    break;
                   }
-                break;
-              }
+                }
             }
 
-          return true;
+          return false;
         });
   if(msg == nullptr)
     {
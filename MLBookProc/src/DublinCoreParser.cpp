@@ -17,527 +17,485 @@
 #include <DublinCoreParser.h>
 #include <XMLAlgorithms.h>
 #include <algorithm>
+#include <string_view>
 
 DublinCoreParser::DublinCoreParser()
 {
-  xml_parser = new XMLParserCPP;
 }
 
 DublinCoreParser::~DublinCoreParser()
 {
-  delete xml_parser;
 }
 
-std::vector<UDBElement>
-DublinCoreParser::dcTitle(const std::vector<XMLElement> &elements)
+DublinCoreMetadata
+DublinCoreParser::dcParse(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
+  DublinCoreMetadata result;
 
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:title", res);
-  std::vector<XMLElement *> res2;
-  XMLAlgorithms::searchElement(res, XMLElement::ElementContent, res2);  
+  DCFound found;
+  dcCollect(elements, found);
+
+  appendContent(found[DCTitle], BaseID::BookTitle, false, result.title);
 
-  for(size_t i = 0; i < res2.size(); i++)
+  dcRoles(found, "aut", BaseID::Author, false, result.author);
+  if(result.author.empty())
     {
-      UDBElement el;
-      bid.setId(el, BaseID::BookTitle);
-      el.content = res2[i]->content;
+      appendContent(found[DCCreator], BaseID::Author, false, result.author);
+    }
 
-      normalizeString(el.content);
+  appendContent(found[DCSubject], BaseID::Genre, false, result.genre);
 
-      result.emplace_back(el);
-    }
+  appendContent(found[DCDate], BaseID::Date, false, result.date);
 
-  return result;
-}
+  XMLAlgorithms::writeXML(found[DCDescription], result.description);
 
-std::vector<UDBElement>
-DublinCoreParser::dcAuthor(const std::vector<XMLElement> &elements)
-{
-  std::vector<UDBElement> result;
+  appendContent(found[DCLanguage], BaseID::Language, true, result.language);
 
-  result = getAuthor1(elements);
-  if(result.empty())
-    {
-      result = getAuthor2(elements);
-    }
-  else
-    {
-      std::vector<UDBElement> l_res = getAuthor2(elements);
-      std::copy(l_res.begin(), l_res.end(), std::back_inserter(result));
-    }
-  if(result.empty())
-    {
-      std::vector<XMLElement *> res;
-      XMLAlgorithms::searchElement(elements, "dc:creator", res);
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res, XMLElement::ElementContent, res2);
-      for(size_t i = 0; i < res2.size(); i++)
-        {
-          UDBElement el;
-          bid.setId(el, BaseID::Author);
-          el.content = res2[i]->content;
-          normalizeString(el.content);
-          result.emplace_back(el);
-        }
-    }
+  dcRoles(found, "trl", BaseID::Translator, true, result.translator);
+
+  appendContent(found[DCPublisher], BaseID::EbookPublisher, true,
+                result.publisher);
+
+  appendContent(found[DCIdentifier], BaseID::EbookID, true,
+                result.identifier);
+
+  appendContent(found[DCSource], BaseID::SourceBookDublinCore, true,
+                result.source);
 
   return result;
 }
 
-std::vector<UDBElement>
-DublinCoreParser::dcGenre(const std::vector<XMLElement> &elements)
+DublinCoreMetadata
+DublinCoreParser::dcParse(const XMLDocument &document)
 {
-  std::vector<UDBElement> result;
+  DublinCoreMetadata result;
 
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:subject", res);
+  DCNodeFound found;
+  dcCollect(document.firstNode(), found);
+
+  appendContent(found[DCTitle], BaseID::BookTitle, false, result.title);
 
-  for(size_t i = 0; i < res.size(); i++)
+  dcRoles(found, "aut", BaseID::Author, false, result.author);
+  if(result.author.empty())
     {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      for(size_t j = 0; j < res2.size(); j++)
-        {
-          UDBElement el;
-          bid.setId(el, BaseID::Genre);
-          el.content = res2[j]->content;
-          normalizeString(el.content);
-          result.emplace_back(el);
-        }
+      appendContent(found[DCCreator], BaseID::Author, false, result.author);
     }
 
+  appendContent(found[DCSubject], BaseID::Genre, false, result.genre);
+
+  appendContent(found[DCDate], BaseID::Date, false, result.date);
+
+  appendContent(found[DCLanguage], BaseID::Language, true, result.language);
+
+  dcRoles(found, "trl", BaseID::Translator, true, result.translator);
+
+  appendContent(found[DCPublisher], BaseID::EbookPublisher, true,
+                result.publisher);
+
+  appendContent(found[DCIdentifier], BaseID::EbookID, true,
+                result.identifier);
+
+  appendContent(found[DCSource], BaseID::SourceBookDublinCore, true,
+                result.source);
+
   return result;
 }
 
 std::vector<UDBElement>
-DublinCoreParser::dcDate(const std::vector<XMLElement> &elements)
+DublinCoreParser::dcTitle(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
+  return dcParse(elements).title;
+}
 
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:date", res); 
+std::vector<UDBElement>
+DublinCoreParser::dcAuthor(const std::vector<XMLElement> &elements)
+{
+  return dcParse(elements).author;
+}
 
-  for(size_t i = 0; i < res.size(); i++)
-    {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      for(size_t j = 0; j < res2.size(); j++)
-        {
-          UDBElement el;
-          bid.setId(el, BaseID::Date);
-          el.content = res2[j]->content;
-          normalizeString(el.content);
-          result.emplace_back(el);
-        }
-    }
+std::vector<UDBElement>
+DublinCoreParser::dcGenre(const std::vector<XMLElement> &elements)
+{
+  return dcParse(elements).genre;
+}
 
-  return result;
+std::vector<UDBElement>
+DublinCoreParser::dcDate(const std::vector<XMLElement> &elements)
+{
+  return dcParse(elements).date;
 }
 
 std::string
 DublinCoreParser::dcDescription(const std::vector<XMLElement> &elements)
 {
-  std::string result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:description", res);
-
-  XMLAlgorithms::writeXML(res, result);
-
-  return result;
+  return dcParse(elements).description;
 }
 
 std::vector<UDBElement>
 DublinCoreParser::dcLanguage(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:language", res);
-
-  for(size_t i = 0; i < res.size(); i++)
-    {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      if(res2.size() == 0)
-        {
-          continue;
-        }
-      UDBElement el;
-      bid.setId(el, BaseID::Language);
-      el.content = res2[0]->content;
-      normalizeString(el.content);
-      if(!el.content.empty())
-        {
-          result.emplace_back(el);
-        }
-    }
-
-  return result;
+  return dcParse(elements).language;
 }
 
 std::vector<UDBElement>
 DublinCoreParser::dcTranslator(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
-
-  result = getTranslator1(elements);
-  if(result.empty())
-    {
-      result = getTranslator2(elements);
-    }
-  else
-    {
-      std::vector<UDBElement> l_res = getTranslator2(elements);
-      std::copy(l_res.begin(), l_res.end(), std::back_inserter(result));
-    }
-
-  return result;
+  return dcParse(elements).translator;
 }
 
 std::vector<UDBElement>
 DublinCoreParser::dcPublisher(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:publisher", res);
-
-  for(size_t i = 0; i < res.size(); i++)
-    {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      if(res2.size() == 0)
-        {
-          continue;
-        }
-      UDBElement el;
-      bid.setId(el, BaseID::EbookPublisher);
-      el.content = res2[0]->content;
-      normalizeString(el.content);
-      if(!el.content.empty())
-        {
-          result.emplace_back(el);
-        }
-    }
-
-  return result;
+  return dcParse(elements).publisher;
 }
 
 std::vector<UDBElement>
 DublinCoreParser::dcIdentifier(const std::vector<XMLElement> &elements)
 {
-  std::vector<UDBElement> result;
+  return dcParse(elements).identifier;
+}
 
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:identifier", res);
+std::vector<UDBElement>
+DublinCoreParser::dcSource(const std::vector<XMLElement> &elements)
+{
+  return dcParse(elements).source;
+}
 
-  for(size_t i = 0; i < res.size(); i++)
+void
+DublinCoreParser::dcCollect(const std::vector<XMLElement> &elements,
+                            DCFound &found)
+{
+  XMLElement *end
+      = const_cast<XMLElement *>(elements.data() + elements.size());
+  for(XMLElement *it_el = const_cast<XMLElement *>(elements.data());
+      it_el != end; it_el++)
     {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      if(res2.size() == 0)
+      const std::string &name = it_el->element_name;
+      DCElement dc_el = dcElement(name);
+      if(dc_el != DCElementCount)
         {
-          continue;
+          found[dc_el].push_back(it_el);
         }
-      UDBElement el;
-      bid.setId(el, BaseID::EbookID);
-      el.content = res2[0]->content;
-      normalizeString(el.content);
-      if(!el.content.empty())
+      else if(name == "meta")
         {
-          result.emplace_back(el);
+          auto it = std::find_if(it_el->element_attributes.begin(),
+                                 it_el->element_attributes.end(),
+                                 [](const XMLElementAttribute &el)
+                                   {
+                                     return el.attribute_id == "property"
+                                            && el.attribute_value == "role";
+                                   });
+          if(it != it_el->element_attributes.end())
+            {
+              found[DCRoleMeta].push_back(it_el);
+            }
         }
+      dcCollect(it_el->elements, found);
     }
-
-  return result;
 }
 
-std::vector<UDBElement>
-DublinCoreParser::dcSource(const std::vector<XMLElement> &elements)
+void
+DublinCoreParser::dcCollect(const XMLNode *node, DCNodeFound &found)
 {
-  std::vector<UDBElement> result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:source", res);
-
-  for(size_t i = 0; i < res.size(); i++)
+  for(; node != nullptr; node = node->next_sibling)
     {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      if(res2.size() == 0)
+      DCElement dc_el = dcElement(node->node_name);
+      if(dc_el != DCElementCount)
         {
-          continue;
+          found[dc_el].push_back(node);
         }
-      UDBElement el;
-      bid.setId(el, BaseID::SourceBookDublinCore);
-      el.content = res2[0]->content;
-      normalizeString(el.content);
-      if(!el.content.empty())
+      else if(node->node_name == "meta")
         {
-          result.emplace_back(el);
+          const XMLNodeAttribute *attr = node->attribute("property");
+          if(attr && attr->attribute_value == "role")
+            {
+              found[DCRoleMeta].push_back(node);
+            }
         }
+      dcCollect(node->first_child, found);
     }
+}
 
-  return result;
+DublinCoreParser::DCElement
+DublinCoreParser::dcElement(const std::string_view &name)
+{
+  if(name.size() <= 3 || name.compare(0, 3, "dc:") != 0)
+    {
+      return DCElementCount;
+    }
+  std::string_view dc_name = name.substr(3);
+  if(dc_name == "title")
+    {
+      return DCTitle;
+    }
+  else if(dc_name == "creator")
+    {
+      return DCCreator;
+    }
+  else if(dc_name == "subject")
+    {
+      return DCSubject;
+    }
+  else if(dc_name == "date")
+    {
+      return DCDate;
+    }
+  else if(dc_name == "description")
+    {
+      return DCDescription;
+    }
+  else if(dc_name == "language")
+    {
+      return DCLanguage;
+    }
+  else if(dc_name == "publisher")
+    {
+      return DCPublisher;
+    }
+  else if(dc_name == "identifier")
+    {
+      return DCIdentifier;
+    }
+  else if(dc_name == "source")
+    {
+      return DCSource;
+    }
+  return DCElementCount;
 }
 
-std::vector<UDBElement>
-DublinCoreParser::getAuthor1(const std::vector<XMLElement> &elements)
+void
+DublinCoreParser::dcRoles(const DCFound &found, const std::string &role,
+                          const BaseID::ID &element_id,
+                          const bool &first_only,
+                          std::vector<UDBElement> &result)
 {
-  std::vector<UDBElement> result;
+  // EPUB 3: <meta refines="#id" property="role">role</meta>
   std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "meta", "property", "role", res);
-  res.erase(std::remove_if(res.begin(), res.end(),
-                           [](const XMLElement *el)
-                             {
-                               std::vector<XMLElement *> res;
-                               XMLAlgorithms::searchElement(
-                                   el->elements, XMLElement::ElementContent,
-                                   res);
-                               for(size_t i = 0; i < res.size(); i++)
-                                 {
-                                   if(res[i]->content == "aut")
-                                     {
-                                       return false;
-                                     }
-                                 }
-                               return true;
-                             }),
-            res.end());
-  for(size_t i = 0; i < res.size(); i++)
+  for(auto it_m = found[DCRoleMeta].begin(); it_m != found[DCRoleMeta].end();
+      it_m++)
     {
-      auto it = std::find_if(res[i]->element_attributes.begin(),
-                             res[i]->element_attributes.end(),
+      std::vector<XMLElement *> content;
+      XMLAlgorithms::searchElement((*it_m)->elements,
+                                   XMLElement::ElementContent, content);
+      auto it_c = std::find_if(content.begin(), content.end(),
+                               [role](const XMLElement *el)
+                                 {
+                                   return el->content == role;
+                                 });
+      if(it_c == content.end())
+        {
+          continue;
+        }
+
+      auto it = std::find_if((*it_m)->element_attributes.begin(),
+                             (*it_m)->element_attributes.end(),
                              [](const XMLElementAttribute &el)
                                {
                                  return el.attribute_id == "refines";
                                });
-      if(it != res[i]->element_attributes.end())
+      if(it == (*it_m)->element_attributes.end())
         {
-          std::string attr_val = it->attribute_value;
-          for(auto it_str = attr_val.begin(); it_str != attr_val.end();)
-            {
-              if(*it_str == '#')
-                {
-                  attr_val.erase(it_str);
-                }
-              else
-                {
-                  break;
-                }
-            }
-
-          std::vector<XMLElement *> res2;
-          XMLAlgorithms::searchElement(elements, "dc:creator", "id", attr_val,
-                                       res2);
-
-          std::string l_result;
-          for(size_t j = 0; j < res2.size(); j++)
-            {
-              std::vector<XMLElement *> res3;
-              XMLAlgorithms::searchElement(res2[j]->elements,
-                                           XMLElement::ElementContent, res3);
+          continue;
+        }
+      std::string::size_type n = it->attribute_value.find_first_not_of('#');
+      if(n == std::string::npos)
+        {
+          n = it->attribute_value.size();
+        }
+      std::string attr_val(it->attribute_value, n);
 
-              for(size_t k = 0; k < res3.size(); k++)
+      res.clear();
+      for(auto it_cr = found[DCCreator].begin();
+          it_cr != found[DCCreator].end(); it_cr++)
+        {
+          auto it_id = std::find_if(
+              (*it_cr)->element_attributes.begin(),
+              (*it_cr)->element_attributes.end(),
+              [attr_val](const XMLElementAttribute &el)
                 {
-                  UDBElement el;
-                  bid.setId(el, BaseID::Author);
-                  el.content = res3[k]->content;
-                  normalizeString(el.content);
-                  result.emplace_back(el);
-                }
+                  return el.attribute_id == "id"
+                         && el.attribute_value == attr_val;
+                });
+          if(it_id != (*it_cr)->element_attributes.end())
+            {
+              res.push_back(*it_cr);
             }
         }
+      appendContent(res, element_id, first_only, result);
     }
 
-  return result;
+  // EPUB 2: <dc:creator opf:role="role">
+  res.clear();
+  std::string find_str(":role");
+  for(auto it_cr = found[DCCreator].begin(); it_cr != found[DCCreator].end();
+      it_cr++)
+    {
+      auto it = std::find_if((*it_cr)->element_attributes.begin(),
+                             (*it_cr)->element_attributes.end(),
+                             [find_str](const XMLElementAttribute &el)
+                               {
+                                 return el.attribute_id.find(find_str)
+                                        != std::string::npos;
+                               });
+      if(it != (*it_cr)->element_attributes.end()
+         && it->attribute_value == role)
+        {
+          res.push_back(*it_cr);
+        }
+    }
+  appendContent(res, element_id, first_only, result);
 }
 
-std::vector<UDBElement>
-DublinCoreParser::getAuthor2(const std::vector<XMLElement> &elements)
+void
+DublinCoreParser::dcRoles(const DCNodeFound &found, const std::string &role,
+                          const BaseID::ID &element_id,
+                          const bool &first_only,
+                          std::vector<UDBElement> &result)
 {
-  std::vector<UDBElement> result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:creator", res);
-  std::string find_str(":role");
-  res.erase(std::remove_if(res.begin(), res.end(),
-                           [find_str](const XMLElement *el)
-                             {
-                               auto it = std::find_if(
-                                   el->element_attributes.begin(),
-                                   el->element_attributes.end(),
-                                   [find_str](const XMLElementAttribute &el)
-                                     {
-                                       std::string::size_type n
-                                           = el.attribute_id.find(find_str);
-                                       return n != std::string::npos;
-                                     });
-                               if(it != el->element_attributes.end())
-                                 {
-                                   if(it->attribute_value == "aut")
-                                     {
-                                       return false;
-                                     }
-                                 }
-                               return true;
-                             }),
-            res.end());
-
-  std::string l_result;
-  for(size_t i = 0; i < res.size(); i++)
+  // EPUB 3: <meta refines="#id" property="role">role</meta>
+  std::vector<const XMLNode *> res;
+  std::vector<const XMLNode *> content;
+  for(auto it_m = found[DCRoleMeta].begin(); it_m != found[DCRoleMeta].end();
+      it_m++)
     {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
+      content.clear();
+      (*it_m)->searchNode(XMLElement::ElementContent, content);
+      auto it_c = std::find_if(content.begin(), content.end(),
+                               [role](const XMLNode *node)
+                                 {
+                                   return node->content == role;
+                                 });
+      if(it_c == content.end())
+        {
+          continue;
+        }
 
-      for(size_t j = 0; j < res2.size(); j++)
+      const XMLNodeAttribute *attr = (*it_m)->attribute("refines");
+      if(attr == nullptr)
         {
-          UDBElement el;
-          bid.setId(el, BaseID::Author);
-          el.content = res2[j]->content;
-          normalizeString(el.content);
-          result.emplace_back(el);
+          continue;
         }
+      std::string_view attr_val = attr->attribute_value;
+      std::string_view::size_type n = attr_val.find_first_not_of('#');
+      if(n == std::string_view::npos)
+        {
+          n = attr_val.size();
+        }
+      attr_val = attr_val.substr(n);
+
+      res.clear();
+      for(auto it_cr = found[DCCreator].begin();
+          it_cr != found[DCCreator].end(); it_cr++)
+        {
+          const XMLNodeAttribute *id = (*it_cr)->attribute("id");
+          if(id && id->attribute_value == attr_val)
+            {
+              res.push_back(*it_cr);
+            }
+        }
+      appendContent(res, element_id, first_only, result);
     }
 
-  return result;
+  // EPUB 2: <dc:creator opf:role="role">
+  res.clear();
+  for(auto it_cr = found[DCCreator].begin(); it_cr != found[DCCreator].end();
+      it_cr++)
+    {
+      for(const XMLNodeAttribute *attr = (*it_cr)->first_attribute;
+          attr != nullptr; attr = attr->next)
+        {
+          if(attr->attribute_id.find(":role") != std::string_view::npos)
+            {
+              if(attr->attribute_value == role)
+                {
+                  res.push_back(*it_cr);
+                }
+              break;
+            }
+        }
+    }
+  appendContent(res, element_id, first_only, result);
 }
 
-std::vector<UDBElement>
-DublinCoreParser::getTranslator1(const std::vector<XMLElement> &elements)
+void
+DublinCoreParser::appendContent(const std::vector<XMLElement *> &source,
+                                const BaseID::ID &element_id,
+                                const bool &first_only,
+                                std::vector<UDBElement> &result)
 {
-  std::vector<UDBElement> result;
   std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "meta", "property", "role", res);
-  res.erase(std::remove_if(res.begin(), res.end(),
-                           [](const XMLElement *el)
-                             {
-                               std::vector<XMLElement *> res;
-                               XMLAlgorithms::searchElement(
-                                   el->elements, XMLElement::ElementContent,
-                                   res);
-                               for(size_t i = 0; i < res.size(); i++)
-                                 {
-                                   if(res[i]->content == "trl")
-                                     {
-                                       return false;
-                                     }
-                                 }
-                               return true;
-                             }),
-            res.end());
-  for(size_t i = 0; i < res.size(); i++)
+  for(auto it = source.begin(); it != source.end(); it++)
     {
-      auto it = std::find_if(res[i]->element_attributes.begin(),
-                             res[i]->element_attributes.end(),
-                             [](const XMLElementAttribute &el)
-                               {
-                                 return el.attribute_id == "refines";
-                               });
-      if(it != res[i]->element_attributes.end())
+      res.clear();
+      XMLAlgorithms::searchElement((*it)->elements,
+                                   XMLElement::ElementContent, res);
+      if(first_only)
         {
-          std::string attr_val = it->attribute_value;
-          for(auto it_str = attr_val.begin(); it_str != attr_val.end();)
+          if(res.size() == 0)
             {
-              if(*it_str == '#')
-                {
-                  attr_val.erase(it_str);
-                }
-              else
-                {
-                  break;
-                }
+              continue;
             }
-
-          std::vector<XMLElement *> res2;
-          XMLAlgorithms::searchElement(elements, "dc:creator", "id", attr_val,
-                                       res2);
-
-          for(size_t j = 0; j < res2.size(); j++)
+          UDBElement el;
+          bid.setId(el, element_id);
+          el.content = res[0]->content;
+          normalizeString(el.content);
+          if(!el.content.empty())
+            {
+              result.emplace_back(el);
+            }
+        }
+      else
+        {
+          for(size_t i = 0; i < res.size(); i++)
             {
-              std::vector<XMLElement *> res3;
-              XMLAlgorithms::searchElement(res2[j]->elements,
-                                           XMLElement::ElementContent, res3);
-              if(res3.size() == 0)
-                {
-                  continue;
-                }
               UDBElement el;
-              bid.setId(el, BaseID::Translator);
-              el.content = res3[0]->content;
+              bid.setId(el, element_id);
+              el.content = res[i]->content;
               normalizeString(el.content);
-              if(!el.content.empty())
-                {
-                  result.emplace_back(el);
-                }
+              result.emplace_back(el);
             }
         }
     }
-
-  return result;
 }
 
-std::vector<UDBElement>
-DublinCoreParser::getTranslator2(const std::vector<XMLElement> &elements)
+void
+DublinCoreParser::appendContent(const std::vector<const XMLNode *> &source,
+                                const BaseID::ID &element_id,
+                                const bool &first_only,
+                                std::vector<UDBElement> &result)
 {
-  std::vector<UDBElement> result;
-
-  std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(elements, "dc:creator", res);
-  std::string find_str(":role");
-  res.erase(std::remove_if(res.begin(), res.end(),
-                           [find_str](const XMLElement *el)
-                             {
-                               auto it = std::find_if(
-                                   el->element_attributes.begin(),
-                                   el->element_attributes.end(),
-                                   [find_str](const XMLElementAttribute &el)
-                                     {
-                                       std::string::size_type n
-                                           = el.attribute_id.find(find_str);
-                                       return n != std::string::npos;
-                                     });
-                               if(it != el->element_attributes.end())
-                                 {
-                                   if(it->attribute_value == "trl")
-                                     {
-                                       return false;
-                                     }
-                                 }
-                               return true;
-                             }),
-            res.end());
-
-  for(size_t i = 0; i < res.size(); i++)
+  std::vector<const XMLNode *> res;
+  for(auto it = source.begin(); it != source.end(); it++)
     {
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res[i]->elements,
-                                   XMLElement::ElementContent, res2);
-      if(res2.size() == 0)
+      res.clear();
+      (*it)->searchNode(XMLElement::ElementContent, res);
+      if(first_only)
         {
-          continue;
+          if(res.size() == 0)
+            {
+              continue;
+            }
+          UDBElement el;
+          bid.setId(el, element_id);
+          el.content = std::string(res[0]->content);
+          normalizeString(el.content);
+          if(!el.content.empty())
+            {
+              result.emplace_back(el);
+            }
         }
-      UDBElement el;
-      bid.setId(el, BaseID::Translator);
-      el.content = res2[0]->content;
-      normalizeString(el.content);
-      if(!el.content.empty())
+      else
         {
-          result.emplace_back(el);
+          for(size_t i = 0; i < res.size(); i++)
+            {
+              UDBElement el;
+              bid.setId(el, element_id);
+              el.content = std::string(res[i]->content);
+              normalizeString(el.content);
+              result.emplace_back(el);
+            }
         }
     }
-
-  return result;
 }
 
 void
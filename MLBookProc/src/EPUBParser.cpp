@@ -41,24 +41,14 @@ EPUBParser::parseBook(const std::string &book_content)
   UDBElement result;
   bid.setId(result, BaseID::Book);
 
-  std::vector<std::tuple<std::string, uint64_t, uint64_t>> filenames;
-  arch->listFilesInZipBuffer(book_content, filenames);
+  LibArchiveZipReader zip(arch, book_content);
 
-  std::string rootfile = epubGetRootFileAddress(book_content, filenames);
+  std::string rootfile = epubGetRootFileAddress(zip);
 
   std::string root_file_content;
   if(!rootfile.empty())
     {
-      for(auto it = filenames.begin(); it != filenames.end(); it++)
-        {
-          if(std::get<0>(*it) == rootfile)
-            {
-              root_file_content = arch->unpackBufferFileToBuffer(
-                  book_content, rootfile,
-                  static_cast<size_t>(std::get<2>(*it)));
-              break;
-            }
-        }
+      root_file_content = zip.unpack(rootfile);
     }
 
   if(!root_file_content.empty())
@@ -74,24 +64,14 @@ EPUBParser::getBookInfo(const std::string &book_content)
 {
   UDBase result;
 
-  std::vector<std::tuple<std::string, uint64_t, uint64_t>> filenames;
-  arch->listFilesInZipBuffer(book_content, filenames);
+  LibArchiveZipReader zip(arch, book_content);
 
-  std::string rootfile = epubGetRootFileAddress(book_content, filenames);
+  std::string rootfile = epubGetRootFileAddress(zip);
 
   std::string root_file_content;
   if(!rootfile.empty())
     {
-      for(auto it = filenames.begin(); it != filenames.end(); it++)
-        {
-          if(std::get<0>(*it) == rootfile)
-            {
-              root_file_content = arch->unpackBufferFileToBuffer(
-                  book_content, rootfile,
-                  static_cast<size_t>(std::get<2>(*it)));
-              break;
-            }
-        }
+      root_file_content = zip.unpack(rootfile);
     }
 
   if(root_file_content.empty())
@@ -100,10 +80,11 @@ EPUBParser::getBookInfo(const std::string &book_content)
     }
 
   std::vector<XMLElement> doc = xml_parser->parseDocument(root_file_content);
+  DublinCoreMetadata metadata = dc_parser->dcParse(doc);
 
   UDBElement el;
   bid.setId(el, BaseID::Annotation);
-  el.content = dc_parser->dcDescription(doc);
+  el.content = std::move(metadata.description);
   normalizeString(el.content);
   if(!el.content.empty())
     {
@@ -115,7 +96,7 @@ EPUBParser::getBookInfo(const std::string &book_content)
   std::string cover_path = epubCoverAddress1(doc);
   if(cover_path.empty())
     {
-      cover_path = epubCoverAddress2(doc, rootfile, book_content, filenames);
+      cover_path = epubCoverAddress2(doc, rootfile, zip);
     }
   else
     {
@@ -132,16 +113,9 @@ EPUBParser::getBookInfo(const std::string &book_content)
 
   if(!cover_path.empty())
     {
-      auto it = std::find_if(
-          filenames.begin(), filenames.end(),
-          [cover_path](const std::tuple<std::string, uint64_t, uint64_t> &el)
-            {
-              return std::get<0>(el) == cover_path;
-            });
-      if(it != filenames.end())
+      if(zip.contains(cover_path))
         {
-          el.content = arch->unpackBufferFileToBuffer(book_content, cover_path,
-                                                      std::get<2>(*it));
+          el.content = zip.unpack(cover_path);
           if(!el.content.empty())
             {
               UDBElement type;
@@ -157,20 +131,15 @@ EPUBParser::getBookInfo(const std::string &book_content)
         }
     }
 
-  std::vector<UDBElement> res = dc_parser->dcLanguage(doc);
-  result.addElements(res);
+  result.addElements(metadata.language);
 
-  res = dc_parser->dcTranslator(doc);
-  result.addElements(res);
+  result.addElements(metadata.translator);
 
-  res = dc_parser->dcPublisher(doc);
-  result.addElements(res);
+  result.addElements(metadata.publisher);
 
-  res = dc_parser->dcIdentifier(doc);
-  result.addElements(res);
+  result.addElements(metadata.identifier);
 
-  res = dc_parser->dcSource(doc);
-  result.addElements(res);
+  result.addElements(metadata.source);
 
   result.shrinkToFit();
 
@@ -178,43 +147,29 @@ EPUBParser::getBookInfo(const std::string &book_content)
 }
 
 std::string
-EPUBParser::epubGetRootFileAddress(
-    const std::string &book_content,
-    const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &filenames)
+EPUBParser::epubGetRootFileAddress(const LibArchiveZipReader &zip)
 {
-  std::string buf;
-  for(auto it = filenames.begin(); it != filenames.end(); it++)
-    {
-      if(std::get<0>(*it) == "META-INF/container.xml")
-        {
-          buf = arch->unpackBufferFileToBuffer(
-              book_content, std::get<0>(*it),
-              static_cast<size_t>(std::get<2>(*it)));
-          break;
-        }
-    }
+  std::string buf = zip.unpack("META-INF/container.xml");
 
   std::string content;
   if(buf.size() > 0)
     {
-      std::vector<XMLElement> elements;
-      elements = xml_parser->parseDocument(buf);
+      XMLDocument doc = xml_parser->parseDocumentView(std::move(buf));
 
-      std::vector<XMLElement *> res;
-      XMLAlgorithms::searchElement(elements, "rootfiles", res);
-      std::vector<XMLElement *> res2;
-      XMLAlgorithms::searchElement(res, "rootfile", "full-path", res2);
-      if(res2.size() > 0)
+      std::vector<const XMLNode *> res;
+      doc.searchNode("rootfiles", res);
+      std::vector<const XMLNode *> res2;
+      for(auto it = res.begin(); it != res.end(); it++)
         {
-          auto it = std::find_if(res2[0]->element_attributes.begin(),
-                                 res2[0]->element_attributes.end(),
-                                 [](const XMLElementAttribute &el)
-                                   {
-                                     return el.attribute_id == "full-path";
-                                   });
-          if(it != res2[0]->element_attributes.end())
+          (*it)->searchNode("rootfile", res2);
+        }
+      for(auto it = res2.begin(); it != res2.end(); it++)
+        {
+          const XMLNodeAttribute *attr = (*it)->attribute("full-path");
+          if(attr)
             {
-              content = it->attribute_value;
+              content = std::string(attr->attribute_value);
+              break;
             }
         }
     }
@@ -225,21 +180,15 @@ void
 EPUBParser::epubParseRootFile(const std::string &root_file_content,
                               UDBElement &result)
 {
-  std::vector<XMLElement> elements;
-
-  elements = xml_parser->parseDocument(root_file_content);
+  XMLDocument doc = xml_parser->parseDocumentView(root_file_content);
 
-  std::vector<UDBElement> res = dc_parser->dcTitle(elements);
-  std::copy(res.begin(), res.end(), std::back_inserter(result.subelements));
-
-  res = dc_parser->dcAuthor(elements);
-  std::copy(res.begin(), res.end(), std::back_inserter(result.subelements));
-
-  res = dc_parser->dcGenre(elements);
-  std::copy(res.begin(), res.end(), std::back_inserter(result.subelements));
-
-  res = dc_parser->dcDate(elements);
-  std::copy(res.begin(), res.end(), std::back_inserter(result.subelements));
+  DublinCoreMetadata metadata = dc_parser->dcParse(doc);
+  for(std::vector<UDBElement> *res :
+      {&metadata.title, &metadata.author, &metadata.genre, &metadata.date})
+    {
+      std::move(res->begin(), res->end(),
+                std::back_inserter(result.subelements));
+    }
 }
 
 std::string
@@ -278,10 +227,9 @@ EPUBParser::epubCoverAddress1(const std::vector<XMLElement> &root_file_content)
 }
 
 std::string
-EPUBParser::epubCoverAddress2(
-    const std::vector<XMLElement> &root_file_content,
-    const std::string &root_file_path, const std::string &book_content,
-    const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &filenames)
+EPUBParser::epubCoverAddress2(const std::vector<XMLElement> &root_file_content,
+                              const std::string &root_file_path,
+                              const LibArchiveZipReader &zip)
 {
   std::string result;
 
@@ -323,20 +271,7 @@ EPUBParser::epubCoverAddress2(
       result = std::string(parent.begin(), parent.end()) + "/" + result;
     }
 
-  auto it_fnm = std::find_if(
-      filenames.begin(), filenames.end(),
-      [result](const std::tuple<std::string, uint64_t, uint64_t> &el)
-        {
-          return std::get<0>(el) == result;
-        });
-  if(it_fnm == filenames.end())
-    {
-      result.clear();
-      return result;
-    }
-
-  std::string buf = arch->unpackBufferFileToBuffer(book_content, result,
-                                                   std::get<2>(*it_fnm));
+  std::string buf = zip.unpack(result);
   if(buf.empty())
     {
       result.clear();
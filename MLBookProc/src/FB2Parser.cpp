@@ -16,6 +16,7 @@
 
 #include <FB2Parser.h>
 #include <XMLAlgorithms.h>
+#include <XMLElementIndex.h>
 #include <XMLTextEncoding.h>
 #include <algorithm>
 #include <iostream>
@@ -42,6 +43,27 @@ FB2Parser::parseBook(const std::string &file_content)
       return result;
     }
 
+  // Only description is needed for collection, so body and binaries are not
+  // parsed if description can be found.
+  std::string description;
+  if(fb2Description(file_content, description))
+    {
+      try
+        {
+          XMLDocument doc
+              = xml_parser->parseDocumentView(std::move(description));
+          if(doc.firstNode())
+            {
+              return fb2GetInfoForBase(doc);
+            }
+        }
+      catch(std::exception &er)
+        {
+          std::osyncstream(std::cout) << "FB2Parser::parseBook: \""
+                                      << er.what() << "\"" << std::endl;
+        }
+    }
+
   std::vector<XMLElement> book_xml;
   try
     {
@@ -90,50 +112,89 @@ FB2Parser::getBookInfo(const std::string &book_content)
           "FB2Parser::getBookInfo: book_content is empty");
     }
 
+  // Description is parsed only. Cover is searched in raw content afterwards,
+  // so body and binaries (except cover one) are not parsed.
   std::vector<XMLElement> book_xml;
-  try
+  std::string description;
+  if(fb2Description(book_content, description))
     {
-      book_xml = xml_parser->parseDocument(book_content);
+      try
+        {
+          book_xml = xml_parser->parseDocument(description);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << "FB2Parser::getBookInfo: \"" << er.what() << "\""
+                    << std::endl;
+        }
     }
-  catch(std::exception &er)
-    {
-      std::cout << "FB2Parser::getBookInfo: \"" << er.what() << "\""
-                << std::endl;
+  bool description_only = book_xml.size() > 0;
 
-      std::string code_page
-          = XMLTextEncoding::detectDocumentEncoding(book_content);
-      std::string l_book;
-      XMLTextEncoding::convertToEncoding(book_content, l_book, code_page,
-                                         "UTF-8");
-
-      std::string find_str1 = "<description>";
-      std::string::size_type n1 = l_book.find(find_str1);
-      if(n1 == std::string::npos)
+  if(!description_only)
+    {
+      try
         {
-          throw std::runtime_error(
-              "FB2Parser::getBookInfo: critical error(1)");
+          book_xml = xml_parser->parseDocument(book_content);
         }
-      std::string find_str2 = "</description>";
-      std::string::size_type n2
-          = l_book.find(find_str2, n1 + find_str1.size());
-      if(n2 == std::string::npos)
+      catch(std::exception &er)
         {
-          throw std::runtime_error(
-              "FB2Parser::getBookInfo: critical error(2)");
+          std::cout << "FB2Parser::getBookInfo: \"" << er.what() << "\""
+                    << std::endl;
+
+          std::string code_page
+              = XMLTextEncoding::detectDocumentEncoding(book_content);
+          std::string l_book;
+          XMLTextEncoding::convertToEncoding(book_content, l_book, code_page,
+                                             "UTF-8");
+
+          std::string find_str1 = "<description>";
+          std::string::size_type n1 = l_book.find(find_str1);
+          if(n1 == std::string::npos)
+            {
+              throw std::runtime_error(
+                  "FB2Parser::getBookInfo: critical error(1)");
+            }
+          std::string find_str2 = "</description>";
+          std::string::size_type n2
+              = l_book.find(find_str2, n1 + find_str1.size());
+          if(n2 == std::string::npos)
+            {
+              throw std::runtime_error(
+                  "FB2Parser::getBookInfo: critical error(2)");
+            }
+          description = std::string(l_book.begin() + n1,
+                                    l_book.begin() + n2 + find_str2.size());
+          book_xml = xml_parser->parseDocument(description);
         }
-      std::string description(l_book.begin() + n1,
-                              l_book.begin() + n2 + find_str2.size());
-      book_xml = xml_parser->parseDocument(description);
     }
 
+  XMLElementIndex index(book_xml);
+
   std::vector<XMLElement *> info;
-  XMLAlgorithms::searchElement(book_xml, "title-info", info);
+  index.searchElement("title-info", info);
 
   std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(info, "annotation", res);
+  index.searchElement(info, "annotation", res);
   if(res.size() == 0)
     {
-      XMLAlgorithms::searchElement(book_xml, "annotation", res);
+      index.searchElement("annotation", res);
+    }
+  std::vector<XMLElement> full_xml;
+  if(res.size() == 0 && description_only
+     && book_content.find("<annotation") != std::string::npos)
+    {
+      // Annotation can be placed outside of description (e.g. in body), so
+      // whole book is parsed in this case.
+      try
+        {
+          full_xml = xml_parser->parseDocument(book_content);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << "FB2Parser::getBookInfo: \"" << er.what() << "\""
+                    << std::endl;
+        }
+      XMLAlgorithms::searchElement(full_xml, "annotation", res);
     }
 
   UDBElement el;
@@ -145,14 +206,21 @@ FB2Parser::getBookInfo(const std::string &book_content)
     }
 
   el = UDBElement();
-  fb2Cover(book_xml, el);
+  if(description_only)
+    {
+      fb2CoverLazy(book_content, book_xml, el);
+    }
+  else
+    {
+      fb2Cover(book_xml, el);
+    }
   if(!el.content.empty())
     {
       result.addElement(el);
     }
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "author", res);
+  index.searchElement(info, "author", res);
   std::vector<UDBElement> elements;
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -162,25 +230,25 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "keywords", res);
+  index.searchElement(info, "keywords", res);
   elements.clear();
   getResult(res, elements, BaseID::Keywords);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "lang", res);
+  index.searchElement(info, "lang", res);
   elements.clear();
   getResult(res, elements, BaseID::Language);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "src-lang", res);
+  index.searchElement(info, "src-lang", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceLanguage);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "translator", res);
+  index.searchElement(info, "translator", res);
   elements.clear();
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -190,16 +258,16 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   info.clear();
-  XMLAlgorithms::searchElement(book_xml, "src-title-info", info);
+  index.searchElement("src-title-info", info);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "book-title", res);
+  index.searchElement(info, "book-title", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookTitle);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "author", res);
+  index.searchElement(info, "author", res);
   elements.clear();
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -209,7 +277,7 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "sequence", res);
+  index.searchElement(info, "sequence", res);
   elements.clear();
   fb2Series(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -219,37 +287,37 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "genre", res);
+  index.searchElement(info, "genre", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookGenre);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "date", res);
+  index.searchElement(info, "date", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookDate);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "keywords", res);
+  index.searchElement(info, "keywords", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookKeywords);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "lang", res);
+  index.searchElement(info, "lang", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookLanguage);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "src-lang", res);
+  index.searchElement(info, "src-lang", res);
   elements.clear();
   getResult(res, elements, BaseID::SourceBookSourceLanguage);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "translator", res);
+  index.searchElement(info, "translator", res);
   elements.clear();
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -259,10 +327,10 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   info.clear();
-  XMLAlgorithms::searchElement(book_xml, "document-info", info);
+  index.searchElement("document-info", info);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "author", res);
+  index.searchElement(info, "author", res);
   elements.clear();
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -272,49 +340,49 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "program-used", res);
+  index.searchElement(info, "program-used", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookProgramUsed);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "date", res);
+  index.searchElement(info, "date", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookDate);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "src-url", res);
+  index.searchElement(info, "src-url", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookSourceUrl);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "src-ocr", res);
+  index.searchElement(info, "src-ocr", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookSourceOCR);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "id", res);
+  index.searchElement(info, "id", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookID);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "version", res);
+  index.searchElement(info, "version", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookVersion);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "history", res);
+  index.searchElement(info, "history", res);
   elements.clear();
   getResult(res, elements, BaseID::EbookHistory);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "publisher", res);
+  index.searchElement(info, "publisher", res);
   elements.clear();
   fb2AuthorBookInfo(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -324,40 +392,40 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   info.clear();
-  XMLAlgorithms::searchElement(book_xml, "publish-info", info);
+  index.searchElement("publish-info", info);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "book-name", res);
+  index.searchElement(info, "book-name", res);
   elements.clear();
   getResult(res, elements, BaseID::PaperBookName);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "publisher", res);
+  index.searchElement(info, "publisher", res);
   elements.clear();
   getResult(res, elements, BaseID::PaperBookPublisher);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "city", res);
+  index.searchElement(info, "city", res);
   elements.clear();
   getResult(res, elements, BaseID::PaperBookCity);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "year", res);
+  index.searchElement(info, "year", res);
   elements.clear();
   getResult(res, elements, BaseID::PaperBookYear);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "isbn", res);
+  index.searchElement(info, "isbn", res);
   elements.clear();
   getResult(res, elements, BaseID::PaperBookISBN);
   result.addElements(elements);
 
   res.clear();
-  XMLAlgorithms::searchElement(info, "sequence", res);
+  index.searchElement(info, "sequence", res);
   elements.clear();
   fb2Series(res, elements);
   for(auto it = elements.begin(); it != elements.end(); it++)
@@ -367,7 +435,7 @@ FB2Parser::getBookInfo(const std::string &book_content)
   result.addElements(elements);
 
   info.clear();
-  XMLAlgorithms::searchElement(book_xml, "custom-info", info);
+  index.searchElement("custom-info", info);
   elements.clear();
   getResult(info, elements, BaseID::CustomInfo);
   result.addElements(elements);
@@ -383,27 +451,68 @@ FB2Parser::fb2GetInfoForBase(const std::vector<XMLElement> &book_xml)
   UDBElement result;
   bid.setId(result, BaseID::Book);
 
+  XMLElementIndex index(book_xml);
+
   std::vector<XMLElement *> title_info;
-  XMLAlgorithms::searchElement(book_xml, "title-info", title_info);
+  index.searchElement("title-info", title_info);
 
   std::vector<XMLElement *> res;
-  XMLAlgorithms::searchElement(title_info, "author", res);
+  index.searchElement(title_info, "author", res);
   result.subelements = fb2Author(res);
 
   res.clear();
-  XMLAlgorithms::searchElement(title_info, "book-title", res);
+  index.searchElement(title_info, "book-title", res);
   getResult(res, result.subelements, BaseID::BookTitle);
 
   res.clear();
-  XMLAlgorithms::searchElement(title_info, "sequence", res);
+  index.searchElement(title_info, "sequence", res);
   fb2Series(res, result.subelements);
 
   res.clear();
-  XMLAlgorithms::searchElement(title_info, "genre", res);
+  index.searchElement(title_info, "genre", res);
   getResult(res, result.subelements, BaseID::Genre);
 
   res.clear();
-  XMLAlgorithms::searchElement(title_info, "date", res);
+  index.searchElement(title_info, "date", res);
+  getResult(res, result.subelements, BaseID::Date);
+
+  result.subelements.shrink_to_fit();
+
+  return result;
+}
+
+UDBElement
+FB2Parser::fb2GetInfoForBase(const XMLDocument &book_xml)
+{
+  UDBElement result;
+  bid.setId(result, BaseID::Book);
+
+  std::vector<const XMLNode *> title_info;
+  book_xml.searchNode("title-info", title_info);
+
+  std::vector<const XMLNode *> res;
+  auto search = [&title_info, &res](const std::string_view &name)
+    {
+      res.clear();
+      for(auto it = title_info.begin(); it != title_info.end(); it++)
+        {
+          (*it)->searchNode(name, res);
+        }
+    };
+
+  search("author");
+  result.subelements = fb2Author(res);
+
+  search("book-title");
+  getResult(res, result.subelements, BaseID::BookTitle);
+
+  search("sequence");
+  fb2Series(res, result.subelements);
+
+  search("genre");
+  getResult(res, result.subelements, BaseID::Genre);
+
+  search("date");
   getResult(res, result.subelements, BaseID::Date);
 
   result.subelements.shrink_to_fit();
@@ -411,6 +520,50 @@ FB2Parser::fb2GetInfoForBase(const std::vector<XMLElement> &book_xml)
   return result;
 }
 
+bool
+FB2Parser::fb2Description(const std::string &book, std::string &result)
+{
+  std::string find_str1 = "<description";
+  std::string::size_type n1 = 0;
+  for(;;)
+    {
+      n1 = book.find(find_str1, n1);
+      if(n1 == std::string::npos || n1 + find_str1.size() >= book.size())
+        {
+          return false;
+        }
+      char ch = book[n1 + find_str1.size()];
+      if(ch == '>' || (ch >= 0 && ch <= 32))
+        {
+          break;
+        }
+      n1 += find_str1.size();
+    }
+
+  std::string find_str2 = "</description>";
+  std::string::size_type n2 = book.find(find_str2, n1 + find_str1.size());
+  if(n2 == std::string::npos)
+    {
+      return false;
+    }
+
+  result.clear();
+  // XML header is kept for encoding detection.
+  std::string::size_type n = book.find("<?xml");
+  if(n != std::string::npos && n < n1)
+    {
+      std::string::size_type n_end = book.find("?>", n);
+      if(n_end != std::string::npos && n_end < n1)
+        {
+          result = book.substr(n, n_end + 2 - n);
+          result.push_back('\n');
+        }
+    }
+  result.append(book, n1, n2 + find_str2.size() - n1);
+
+  return true;
+}
+
 std::vector<UDBElement>
 FB2Parser::fb2Author(const std::vector<XMLElement *> &author)
 {
@@ -484,6 +637,52 @@ FB2Parser::fb2Author(const std::vector<XMLElement *> &author)
   return result;
 }
 
+std::vector<UDBElement>
+FB2Parser::fb2Author(const std::vector<const XMLNode *> &author)
+{
+  const std::pair<std::string_view, BaseID::ID> names[]
+      = {{"last-name", BaseID::LastName},
+         {"first-name", BaseID::FirstName},
+         {"middle-name", BaseID::MiddleName},
+         {"nickname", BaseID::Nickname}};
+
+  std::vector<UDBElement> result;
+  std::vector<const XMLNode *> res;
+  std::vector<const XMLNode *> res2;
+  for(size_t i = 0; i < author.size(); i++)
+    {
+      UDBElement l_result;
+      bid.setId(l_result, BaseID::Author);
+
+      for(const std::pair<std::string_view, BaseID::ID> &name : names)
+        {
+          res.clear();
+          res2.clear();
+          author[i]->searchNode(name.first, res);
+          for(auto it = res.begin(); it != res.end(); it++)
+            {
+              (*it)->searchNode(XMLElement::ElementContent, res2);
+            }
+          if(res2.size() > 0)
+            {
+              UDBElement sub_el;
+              bid.setId(sub_el, name.second);
+              sub_el.content = std::string(res2[0]->content);
+              normalizeString(sub_el.content);
+              l_result.subelements.emplace_back(sub_el);
+            }
+        }
+
+      if(l_result.subelements.size() > 0)
+        {
+          l_result.subelements.shrink_to_fit();
+          result.emplace_back(l_result);
+        }
+    }
+
+  return result;
+}
+
 void
 FB2Parser::fb2AuthorBookInfo(const std::vector<XMLElement *> &author,
                              std::vector<UDBElement> &result)
@@ -668,6 +867,51 @@ FB2Parser::fb2Series(const std::vector<XMLElement *> &sequence,
     }
 }
 
+void
+FB2Parser::fb2Series(const std::vector<const XMLNode *> &sequence,
+                     std::vector<UDBElement> &book_subelements)
+{
+  for(size_t i = 0; i < sequence.size(); i++)
+    {
+      UDBElement l_result;
+      bid.setId(l_result, BaseID::Sequence);
+      l_result.subelements.reserve(2);
+      const XMLNodeAttribute *attr = sequence[i]->attribute("name");
+      if(attr)
+        {
+          UDBElement sub;
+          bid.setId(sub, BaseID::SequenceName);
+          sub.content = std::string(attr->attribute_value);
+          normalizeString(sub.content);
+          if(!sub.content.empty())
+            {
+              l_result.subelements.emplace_back(sub);
+            }
+        }
+
+      if(l_result.subelements.size() > 0)
+        {
+          attr = sequence[i]->attribute("number");
+          if(attr)
+            {
+              UDBElement sub;
+              bid.setId(sub, BaseID::SequenceNumber);
+              sub.content = std::string(attr->attribute_value);
+              normalizeString(sub.content);
+              if(!sub.content.empty())
+                {
+                  l_result.subelements.emplace_back(sub);
+                }
+            }
+        }
+
+      if(l_result.subelements.size() > 0)
+        {
+          book_subelements.emplace_back(l_result);
+        }
+    }
+}
+
 void
 FB2Parser::fb2Annotation(const std::vector<XMLElement *> &annotation,
                          std::string &result)
@@ -726,31 +970,9 @@ FB2Parser::fb2CoverGetImage(const std::vector<XMLElement> &book_xml,
 {
   if(image.size() > 0)
     {
-      auto it_attr = std::find_if(image[0]->element_attributes.begin(),
-                                  image[0]->element_attributes.end(),
-                                  [](const XMLElementAttribute &el)
-                                    {
-                                      return el.attribute_id == "l:href";
-                                    });
-      if(it_attr != image[0]->element_attributes.end())
+      std::string cover_name = fb2CoverName(image);
+      if(!cover_name.empty())
         {
-          std::string cover_name = it_attr->attribute_value;
-          for(auto it = cover_name.begin(); it != cover_name.end();)
-            {
-              char ch = *it;
-              if(ch >= 0 && ch <= 32)
-                {
-                  cover_name.erase(it);
-                }
-              else if(ch == '#')
-                {
-                  cover_name.erase(it);
-                }
-              else
-                {
-                  break;
-                }
-            }
           std::vector<XMLElement *> binary;
           XMLAlgorithms::searchElement(book_xml, "binary", "id", cover_name,
                                        binary);
@@ -776,6 +998,275 @@ FB2Parser::fb2CoverGetImage(const std::vector<XMLElement> &book_xml,
     }
 }
 
+void
+FB2Parser::fb2CoverLazy(const std::string &book_content,
+                        const std::vector<XMLElement> &description,
+                        UDBElement &result)
+{
+  bid.setId(result, BaseID::CoverPage);
+
+  std::vector<XMLElement *> coverpage;
+  XMLAlgorithms::searchElement(description, "coverpage", coverpage);
+  std::vector<XMLElement *> image;
+  XMLAlgorithms::searchElement(coverpage, "image", "l:href", image);
+  std::string cover_name = fb2CoverName(image);
+  if(!cover_name.empty())
+    {
+      fb2Binary(book_content, cover_name, result.content);
+      if(!result.content.empty())
+        {
+          UDBElement el;
+          bid.setId(el, BaseID::CoverType);
+          el.content = "base64";
+          result.subelements.emplace_back(el);
+          return void();
+        }
+    }
+
+  std::vector<XMLElement> paragraphs;
+  fb2TextCover(book_content, paragraphs);
+  if(paragraphs.size() > 0)
+    {
+      XMLAlgorithms::writeXML(paragraphs, result.content);
+      UDBElement el;
+      bid.setId(el, BaseID::CoverType);
+      el.content = "text";
+      result.subelements.emplace_back(el);
+    }
+  else
+    {
+      std::vector<XMLElement> book_xml;
+      try
+        {
+          book_xml = xml_parser->parseDocument(book_content);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << "FB2Parser::fb2CoverLazy: \"" << er.what() << "\""
+                    << std::endl;
+          return void();
+        }
+      result = UDBElement();
+      fb2Cover(book_xml, result);
+    }
+}
+
+std::string
+FB2Parser::fb2CoverName(const std::vector<XMLElement *> &image)
+{
+  std::string cover_name;
+  if(image.size() == 0)
+    {
+      return cover_name;
+    }
+  auto it_attr = std::find_if(image[0]->element_attributes.begin(),
+                              image[0]->element_attributes.end(),
+                              [](const XMLElementAttribute &el)
+                                {
+                                  return el.attribute_id == "l:href";
+                                });
+  if(it_attr != image[0]->element_attributes.end())
+    {
+      cover_name = it_attr->attribute_value;
+      for(auto it = cover_name.begin(); it != cover_name.end();)
+        {
+          char ch = *it;
+          if(ch >= 0 && ch <= 32)
+            {
+              cover_name.erase(it);
+            }
+          else if(ch == '#')
+            {
+              cover_name.erase(it);
+            }
+          else
+            {
+              break;
+            }
+        }
+    }
+
+  return cover_name;
+}
+
+void
+FB2Parser::fb2Binary(const std::string &book_content, const std::string &id,
+                     std::string &result)
+{
+  // Binaries are placed at the end of fb2 files, so search is started from
+  // the end.
+  std::string find_str = "<binary";
+  std::string::size_type n = book_content.size();
+  while(n > 0)
+    {
+      n = book_content.rfind(find_str, n - 1);
+      if(n == std::string::npos)
+        {
+          break;
+        }
+      std::string::size_type tag_end = book_content.find('>', n);
+      if(tag_end == std::string::npos)
+        {
+          continue;
+        }
+
+      bool found = false;
+      std::string::size_type n_id = n + find_str.size();
+      for(;;)
+        {
+          n_id = book_content.find("id", n_id);
+          if(n_id == std::string::npos || n_id > tag_end)
+            {
+              break;
+            }
+          char ch = book_content[n_id - 1];
+          n_id += 2;
+          if(ch < 0 || ch > 32)
+            {
+              continue;
+            }
+          std::string::size_type pos = n_id;
+          while(pos < tag_end && book_content[pos] >= 0
+                && book_content[pos] <= 32)
+            {
+              pos++;
+            }
+          if(pos >= tag_end || book_content[pos] != '=')
+            {
+              continue;
+            }
+          pos++;
+          while(pos < tag_end && book_content[pos] >= 0
+                && book_content[pos] <= 32)
+            {
+              pos++;
+            }
+          if(pos >= tag_end
+             || (book_content[pos] != '\"' && book_content[pos] != '\''))
+            {
+              continue;
+            }
+          std::string::size_type val_end
+              = book_content.find(book_content[pos], pos + 1);
+          if(val_end == std::string::npos || val_end > tag_end)
+            {
+              break;
+            }
+          found = book_content.compare(pos + 1, val_end - pos - 1, id) == 0;
+          break;
+        }
+
+      if(found)
+        {
+          std::string::size_type n_end
+              = book_content.find("</binary>", tag_end);
+          if(n_end != std::string::npos)
+            {
+              result = book_content.substr(tag_end + 1, n_end - tag_end - 1);
+            }
+          break;
+        }
+    }
+}
+
+void
+FB2Parser::fb2TextCover(const std::string &book_content,
+                        std::vector<XMLElement> &result)
+{
+  std::string find_str = "<body";
+  std::string::size_type n = book_content.find(find_str);
+  if(n == std::string::npos)
+    {
+      return void();
+    }
+
+  std::string body;
+  // XML header is kept for encoding detection.
+  std::string::size_type n_h = book_content.find("<?xml");
+  if(n_h != std::string::npos && n_h < n)
+    {
+      std::string::size_type n_h_end = book_content.find("?>", n_h);
+      if(n_h_end != std::string::npos && n_h_end < n)
+        {
+          body = book_content.substr(n_h, n_h_end + 2 - n_h);
+          body.push_back('\n');
+        }
+    }
+  // Binaries follow bodies, so they are excluded if possible.
+  std::string::size_type n_bin = book_content.find("<binary", n);
+  if(n_bin == std::string::npos)
+    {
+      n_bin = book_content.size();
+    }
+  body.append(book_content, n, n_bin - n);
+
+  std::vector<XMLElement> stack;
+  try
+    {
+      xml_parser->parseDocumentStream(
+          body,
+          [&stack, &result](XMLStreamEvent &event)
+            {
+              switch(event.event_type)
+                {
+                case XMLStreamEvent::StartElement:
+                  {
+                    if(stack.size() > 0 || event.element_name == "p")
+                      {
+                        XMLElement el;
+                        el.element_name = std::move(event.element_name);
+                        el.element_attributes
+                            = std::move(event.element_attributes);
+                        stack.emplace_back(std::move(el));
+                      }
+                    break;
+                  }
+                case XMLStreamEvent::Content:
+                  {
+                    if(stack.size() > 0)
+                      {
+                        XMLElement el;
+                        el.element_type = XMLElement::ElementContent;
+                        el.content = std::move(event.content);
+                        stack.rbegin()->elements.emplace_back(std::move(el));
+                      }
+                    break;
+                  }
+                case XMLStreamEvent::EndElement:
+                  {
+                    if(stack.size() > 0)
+                      {
+                        XMLElement el = std::move(*stack.rbegin());
+                        stack.pop_back();
+                        if(stack.size() > 0)
+                          {
+                            stack.rbegin()->elements.emplace_back(
+                                std::move(el));
+                          }
+                        else
+                          {
+                            result.emplace_back(std::move(el));
+                          }
+                      }
+                    else if(event.element_name == "body")
+                      {
+                        return false;
+                      }
+                    break;
+                  }
+                default:
+                  break;
+                }
+              return result.size() < 50;
+            });
+    }
+  catch(std::exception &er)
+    {
+      std::cout << "FB2Parser::fb2TextCover: \"" << er.what() << "\""
+                << std::endl;
+    }
+}
+
 void
 FB2Parser::getResult(const std::vector<XMLElement *> &elements,
                      std::vector<UDBElement> &result,
@@ -802,6 +1293,31 @@ FB2Parser::getResult(const std::vector<XMLElement *> &elements,
     }
 }
 
+void
+FB2Parser::getResult(const std::vector<const XMLNode *> &nodes,
+                     std::vector<UDBElement> &result,
+                     const BaseID::ID &element_id)
+{
+  std::vector<const XMLNode *> res;
+  for(size_t i = 0; i < nodes.size(); i++)
+    {
+      res.clear();
+      nodes[i]->searchNode(XMLElement::ElementContent, res);
+      if(res.size() == 0)
+        {
+          continue;
+        }
+      UDBElement el;
+      bid.setId(el, element_id);
+      el.content = std::string(res[0]->content);
+      normalizeString(el.content);
+      if(!el.content.empty())
+        {
+          result.emplace_back(el);
+        }
+    }
+}
+
 void
 FB2Parser::normalizeString(std::string &str)
 {
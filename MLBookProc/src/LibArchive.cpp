@@ -16,6 +16,7 @@
 
 #include <ByteOrder.h>
 #include <LibArchive.h>
+#include <LibArchiveMemoryStream.h>
 #include <XMLTextEncoding.h>
 #include <algorithm>
 #include <archive_entry.h>
@@ -24,6 +25,8 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 #ifdef __linux
 #include <grp.h>
@@ -149,7 +152,7 @@ LibArchive::listFilesInArchiveBuffer(
     std::vector<std::tuple<std::string, uint64_t, uint64_t>> &result)
 {
   std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
-  fd->source_buffer = buffer;
+  fd->source_view = buffer;
 
   std::shared_ptr<archive> a = initForReading(fd);
 
@@ -241,33 +244,12 @@ LibArchive::listFilesInZip(
     const std::filesystem::path &archive_path,
     std::vector<std::tuple<std::string, uint64_t, uint64_t>> &result)
 {
-  std::shared_ptr<std::fstream> f(new std::fstream,
-                                  [](std::fstream *f)
-                                    {
-                                      delete f;
-                                    });
-  f->open(archive_path, std::ios_base::in | std::ios_base::binary);
-  if(!f->is_open())
-    {
-      std::string err = "LibArchive::listFilesInZip: cannot open file ";
-      std::u8string u8str = archive_path.u8string();
-      err += std::string(u8str.begin(), u8str.end());
-      throw std::runtime_error(err);
-    }
-
-  f->seekg(0, std::ios_base::end);
-  uint64_t fsz = static_cast<uint64_t>(f->tellg());
-
-  std::string central_directory;
   try
     {
-      getCentralDirectory(f, fsz, central_directory);
-
-      parseCentralDirectory(central_directory, result);
+      listFilesInZipCentralDirectory(archive_path, result);
     }
   catch(std::exception &er)
     {
-      f.reset();
       std::cout << er.what() << std::endl;
       result.clear();
       listFilesInArchive(archive_path, result);
@@ -279,15 +261,10 @@ LibArchive::listFilesInZipBuffer(
     const std::string &buffer,
     std::vector<std::tuple<std::string, uint64_t, uint64_t>> &result)
 {
-  std::shared_ptr<std::stringstream> str(new std::stringstream,
-                                         [](std::stringstream *str)
-                                           {
-                                             delete str;
-                                           });
-  str->str(buffer);
+  std::shared_ptr<LibArchiveMemoryStream> str(
+      new LibArchiveMemoryStream(buffer.data(), buffer.size()));
 
-  str->seekg(0, std::ios_base::end);
-  uint64_t fsz = static_cast<uint64_t>(str->tellg());
+  uint64_t fsz = static_cast<uint64_t>(buffer.size());
 
   std::string central_directory;
   try
@@ -330,7 +307,7 @@ LibArchive::unpackBufferFileToDirectory(const std::string &buffer,
 {
   std::filesystem::path result;
   std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
-  fd->source_buffer = buffer;
+  fd->source_view = buffer;
   fd->start_offset = offset;
 
   result = unpackToDirectory(fd, filename, directory);
@@ -414,7 +391,7 @@ LibArchive::unpackBufferFileToBuffer(const std::string &buffer,
 {
   std::string result;
   std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
-  fd->source_buffer = buffer;
+  fd->source_view = buffer;
   fd->start_offset = offset;
 
   unpackToBuffer(fd, filename, result);
@@ -470,6 +447,208 @@ LibArchive::unpackZipBufferFileToBuffer(const std::string &buffer,
   return result;
 }
 
+std::vector<std::string>
+LibArchive::unpackFilesToBuffers(const std::filesystem::path &archive_path,
+                                 const std::vector<std::string> &filenames)
+{
+  std::vector<std::string> result;
+  result.resize(filenames.size());
+
+  std::shared_ptr<LibArchiveCache> cache = mlbp->getArchiveCache();
+  size_t left = 0;
+  std::vector<bool> found(filenames.size(), false);
+  for(size_t i = 0; i < filenames.size(); i++)
+    {
+      std::filesystem::perms perms;
+      if(cache->getEntry(archive_path, filenames[i], result[i], perms))
+        {
+          found[i] = true;
+        }
+      else
+        {
+          left++;
+        }
+    }
+  if(left == 0)
+    {
+      return result;
+    }
+
+  std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
+  fd->path = archive_path;
+  fd->open_mode = std::ios_base::in | std::ios_base::binary;
+
+  std::shared_ptr<archive> a = initForReading(fd);
+
+  int er = archive_read_set_seek_callback(a.get(), &LibArchive::seekCallback);
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(a, "LibArchive::unpackFilesToBuffers:");
+    }
+
+  er = archive_read_open2(a.get(), fd.get(), &LibArchive::openCallBack,
+                          &LibArchive::readCallBack, &LibArchive::skipCallback,
+                          &LibArchive::closeCallback);
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(a, "LibArchive::unpackFilesToBuffers:");
+    }
+
+  std::shared_ptr<archive_entry> e(archive_entry_new(),
+                                   [](archive_entry *e)
+                                     {
+                                       archive_entry_free(e);
+                                     });
+  int retry_count = 0;
+  size_t read_ahead = 0;
+  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3
+        && (left > 0 || read_ahead > 0))
+    {
+      er = archive_read_next_header2(a.get(), e.get());
+      switch(er)
+        {
+        case ARCHIVE_WARN:
+          {
+            const char *str = archive_error_string(a.get());
+            std::string err;
+            if(str)
+              {
+                err = std::string("LibArchive::unpackFilesToBuffers: \"")
+                      + str + "\"";
+              }
+            else
+              {
+                err = std::string("LibArchive::unpackFilesToBuffers: ")
+                      + std::strerror(archive_errno(a.get()));
+              }
+            std::cout << err << std::endl;
+          }
+        case ARCHIVE_OK:
+          {
+            retry_count = 0;
+            const char *val = archive_entry_pathname_utf8(e.get());
+            if(val == nullptr)
+              {
+                break;
+              }
+            std::string name(val);
+            bool solid = solidFormat(a);
+            bool requested = false;
+            size_t first = 0;
+            for(size_t i = 0; i < filenames.size(); i++)
+              {
+                if(!found[i] && filenames[i] == name)
+                  {
+                    if(!requested)
+                      {
+                        result[i] = unpackEntryToBuffer(a, e);
+                        if(solid)
+                          {
+                            cache->addEntry(archive_path, name, result[i],
+                                            getPermissionsFromEntry(e));
+                          }
+                        requested = true;
+                        first = i;
+                      }
+                    else
+                      {
+                        result[i] = result[first];
+                      }
+                    found[i] = true;
+                    left--;
+                  }
+              }
+            if(requested)
+              {
+                if(left == 0 && solid)
+                  {
+                    read_ahead = cache->getCacheSize() / 4;
+                  }
+              }
+            else if(left == 0)
+              {
+                if(!cacheEntry(a, e, archive_path, cache, read_ahead))
+                  {
+                    read_ahead = 0;
+                  }
+              }
+            break;
+          }
+        case ARCHIVE_EOF:
+          {
+            break;
+          }
+        case ARCHIVE_RETRY:
+          {
+            retry_count++;
+            break;
+          }
+        default:
+          {
+            archiveError(a, "LibArchive::unpackFilesToBuffers:");
+            break;
+          }
+        }
+      archive_entry_clear(e.get());
+    }
+
+  return result;
+}
+
+std::vector<std::filesystem::path>
+LibArchive::unpackFilesToDirectories(
+    const std::vector<std::tuple<std::filesystem::path, std::string,
+                                 std::filesystem::path>> &requests)
+{
+  std::vector<std::filesystem::path> result;
+  result.resize(requests.size());
+
+  std::vector<std::tuple<
+      std::filesystem::path,
+      std::vector<std::tuple<std::string, std::filesystem::path, size_t>>>>
+      groups;
+  for(size_t i = 0; i < requests.size(); i++)
+    {
+      auto it = std::find_if(
+          groups.begin(), groups.end(),
+          [&requests, i](
+              const std::tuple<std::filesystem::path,
+                               std::vector<std::tuple<
+                                   std::string, std::filesystem::path, size_t>>>
+                  &el)
+            {
+              return std::get<0>(el) == std::get<0>(requests[i]);
+            });
+      if(it == groups.end())
+        {
+          groups.emplace_back(std::make_tuple(
+              std::get<0>(requests[i]),
+              std::vector<
+                  std::tuple<std::string, std::filesystem::path, size_t>>()));
+          it = groups.end() - 1;
+        }
+      std::get<1>(*it).emplace_back(std::make_tuple(
+          std::get<1>(requests[i]), std::get<2>(requests[i]), i));
+    }
+
+#pragma omp parallel for schedule(dynamic)
+  for(size_t i = 0; i < groups.size(); i++)
+    {
+      try
+        {
+          unpackGroupToDirectories(std::get<0>(groups[i]),
+                                   std::get<1>(groups[i]), result);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << "LibArchive::unpackFilesToDirectories: \""
+                    << er.what() << "\"" << std::endl;
+        }
+    }
+
+  return result;
+}
+
 void
 LibArchive::writeToArchive(const std::filesystem::path &source_object,
                            const std::filesystem::path &archive_path,
@@ -539,12 +718,17 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
         }
     }
 
-  er = archive_write_open(
-      a_write.get(), fd_write.get(), &LibArchive::openCallBack,
-      &LibArchive::writeCallback, &LibArchive::closeCallback);
-  if(er != ARCHIVE_OK)
+  std::shared_ptr<LibArchiveZipWriter> zip_writer
+      = setWriteThreads(a_write, fd_write);
+  if(a_write)
     {
-      archiveError(a_write, "LibArchive::writeToArchive:");
+      er = archive_write_open(
+          a_write.get(), fd_write.get(), &LibArchive::openCallBack,
+          &LibArchive::writeCallback, &LibArchive::closeCallback);
+      if(er != ARCHIVE_OK)
+        {
+          archiveError(a_write, "LibArchive::writeToArchive:");
+        }
     }
 
   std::vector<std::string> names;
@@ -609,6 +793,7 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
                     if(p_in_arch == name_in_archive)
                       {
                         a_write.reset();
+                        zip_writer.reset();
                         fd_write->f.reset();
                         std::filesystem::remove_all(fd_write->path);
                         throw std::runtime_error("LibArchive::writeToArchive: "
@@ -619,18 +804,7 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
 
                 std::string buf = unpackEntryToBuffer(a_read, e);
                 setUsernameGroupname(e);
-                if(buf.size() > 0)
-                  {
-                    writeBufferToArchive(a_write, e, buf);
-                  }
-                else
-                  {
-                    er = archive_write_header(a_write.get(), e.get());
-                    if(er != ARCHIVE_OK)
-                      {
-                        archiveError(a_write, "LibArchive::writeToArchive:");
-                      }
-                  }
+                writeEntry(a_write, zip_writer, e, buf);
                 break;
               }
             case ARCHIVE_EOF:
@@ -679,13 +853,15 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
                   if(it != names.end())
                     {
                       a_write.reset();
+                      zip_writer.reset();
                       fd_write->f.reset();
                       std::filesystem::remove_all(fd_write->path);
                       throw std::runtime_error("LibArchive::writeToArchive: "
                                                "file already in archive!");
                     }
                   writeFile(a_write, p,
-                            std::string(u8str.begin(), u8str.end()), perms);
+                            std::string(u8str.begin(), u8str.end()), perms,
+                            zip_writer);
                   break;
                 }
               case std::filesystem::file_type::symlink:
@@ -708,6 +884,7 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
                       if(it_n != names.end())
                         {
                           a_write.reset();
+                          zip_writer.reset();
                           fd_write->f.reset();
                           std::filesystem::remove_all(fd_write->path);
                           throw std::runtime_error(
@@ -716,7 +893,7 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
                         }
                       writeFile(a_write, std::get<1>(*it),
                                 std::string(u8str.begin(), u8str.end()),
-                                perms);
+                                perms, zip_writer);
                     }
                   break;
                 }
@@ -732,12 +909,14 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
         if(it_n != names.end())
           {
             a_write.reset();
+            zip_writer.reset();
             fd_write->f.reset();
             std::filesystem::remove_all(fd_write->path);
             throw std::runtime_error("LibArchive::writeToArchive: "
                                      "file already in archive!");
           }
-        writeFile(a_write, source_object, name_in_archive, perms);
+        writeFile(a_write, source_object, name_in_archive, perms,
+                  zip_writer);
         break;
       }
     case std::filesystem::file_type::symlink:
@@ -755,19 +934,25 @@ LibArchive::writeToArchive(const std::filesystem::path &source_object,
             if(it_n != names.end())
               {
                 a_write.reset();
+                zip_writer.reset();
                 fd_write->f.reset();
                 std::filesystem::remove_all(fd_write->path);
                 throw std::runtime_error("LibArchive::writeToArchive: "
                                          "file already in archive!");
               }
             writeFile(a_write, std::get<1>(*it),
-                      std::string(u8str.begin(), u8str.end()), perms);
+                      std::string(u8str.begin(), u8str.end()), perms,
+                      zip_writer);
           }
         break;
       }
     default:
       break;
     }
+  if(zip_writer)
+    {
+      zip_writer->finish();
+    }
   if(exist)
     {
       a_write.reset();
@@ -840,12 +1025,17 @@ LibArchive::writeBufferObjectToArchive(
         }
     }
 
-  er = archive_write_open(
-      a_write.get(), fd_write.get(), &LibArchive::openCallBack,
-      &LibArchive::writeCallback, &LibArchive::closeCallback);
-  if(er != ARCHIVE_OK)
+  std::shared_ptr<LibArchiveZipWriter> zip_writer
+      = setWriteThreads(a_write, fd_write);
+  if(a_write)
     {
-      archiveError(a_write, "LibArchive::writeBufferToArchive:");
+      er = archive_write_open(
+          a_write.get(), fd_write.get(), &LibArchive::openCallBack,
+          &LibArchive::writeCallback, &LibArchive::closeCallback);
+      if(er != ARCHIVE_OK)
+        {
+          archiveError(a_write, "LibArchive::writeBufferToArchive:");
+        }
     }
 
   std::vector<std::string> names;
@@ -910,6 +1100,7 @@ LibArchive::writeBufferObjectToArchive(
                     if(p_in_arch == name_in_archive)
                       {
                         a_write.reset();
+                        zip_writer.reset();
                         fd_write->f.reset();
                         std::filesystem::remove_all(fd_write->path);
                         throw std::runtime_error(
@@ -921,19 +1112,7 @@ LibArchive::writeBufferObjectToArchive(
 
                 std::string buf = unpackEntryToBuffer(a_read, e);
                 setUsernameGroupname(e);
-                if(buf.size() > 0)
-                  {
-                    writeBufferToArchive(a_write, e, buf);
-                  }
-                else
-                  {
-                    er = archive_write_header(a_write.get(), e.get());
-                    if(er != ARCHIVE_OK)
-                      {
-                        archiveError(a_write,
-                                     "LibArchive::writeBufferToArchive:");
-                      }
-                  }
+                writeEntry(a_write, zip_writer, e, buf);
                 break;
               }
             case ARCHIVE_EOF:
@@ -986,7 +1165,15 @@ LibArchive::writeBufferObjectToArchive(
 
   setUsernameGroupname(e);
 
-  writeBufferToArchive(a_write, e, buffer);
+  if(zip_writer)
+    {
+      zip_writer->addEntry(e, buffer);
+      zip_writer->finish();
+    }
+  else
+    {
+      writeBufferToArchive(a_write, e, buffer);
+    }
 
   if(exist)
     {
@@ -997,88 +1184,454 @@ LibArchive::writeBufferObjectToArchive(
     }
 }
 
-std::shared_ptr<archive>
-LibArchive::initForReading(const std::shared_ptr<LibArchiveFileData> &fd)
+void
+LibArchive::listFilesInZipCentralDirectory(
+    const std::filesystem::path &archive_path,
+    std::vector<std::tuple<std::string, uint64_t, uint64_t>> &result)
 {
-  std::shared_ptr<archive> result(archive_read_new(),
-                                  [fd](archive *a)
+  std::shared_ptr<std::fstream> f(new std::fstream,
+                                  [](std::fstream *f)
                                     {
-                                      archive_read_free(a);
+                                      delete f;
                                     });
-  int er = archive_read_support_filter_all(result.get());
-  if(er != ARCHIVE_OK)
-    {
-      archiveError(result, "LibArchive::openForReading:");
-    }
-
-  er = archive_read_support_format_all(result.get());
-  if(er != ARCHIVE_OK)
+  f->open(archive_path, std::ios_base::in | std::ios_base::binary);
+  if(!f->is_open())
     {
-      archiveError(result, "LibArchive::openForReading:");
+      std::string err
+          = "LibArchive::listFilesInZipCentralDirectory: cannot open file ";
+      std::u8string u8str = archive_path.u8string();
+      err += std::string(u8str.begin(), u8str.end());
+      throw std::runtime_error(err);
     }
 
-  return result;
-}
+  f->seekg(0, std::ios_base::end);
+  uint64_t fsz = static_cast<uint64_t>(f->tellg());
 
-std::shared_ptr<archive>
-LibArchive::initForWriting(const std::shared_ptr<LibArchiveFileData> &fd)
-{
-  std::shared_ptr<archive> result
-      = std::shared_ptr<archive>(archive_write_new(),
-                                 [](archive *a)
-                                   {
-                                     archive_free(a);
-                                   });
+  std::string central_directory;
+  getCentralDirectory(f, fsz, central_directory);
 
-  return result;
+  parseCentralDirectory(central_directory, result);
 }
 
-void
-LibArchive::archiveError(const std::shared_ptr<archive> &a,
-                         const std::string &message)
+size_t
+LibArchive::removeFromZip(const std::filesystem::path &archive_path,
+                          const std::vector<std::string> &filenames,
+                          const bool &keep_holes)
 {
-  const char *str = archive_error_string(a.get());
-  if(str)
+  std::shared_ptr<std::fstream> f(new std::fstream,
+                                  [](std::fstream *f)
+                                    {
+                                      delete f;
+                                    });
+  f->open(archive_path,
+          std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+  if(!f->is_open())
     {
-      std::string err = message + " \"" + str + "\"";
-      throw std::runtime_error(err);
+      std::string err = "LibArchive::removeFromZip: cannot open file ";
+      std::u8string u8str = archive_path.u8string();
+      err += std::string(u8str.begin(), u8str.end());
+      throw std::invalid_argument(err);
     }
-  else
+
+  f->seekg(0, std::ios_base::end);
+  uint64_t fsz = static_cast<uint64_t>(f->tellg());
+  if(fsz < 22)
     {
-      std::string err = message + " " + std::strerror(archive_errno(a.get()));
-      throw std::runtime_error(err);
+      throw std::invalid_argument("LibArchive::removeFromZip: not a zip file");
     }
-}
 
-int
-LibArchive::openCallBack(archive *a, void *client_data)
-{
-  int result = ARCHIVE_FATAL;
-
-  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
-  if(fd->source_buffer.empty())
+  ByteOrder bo;
+  auto get16 = [&bo](const std::string &buf, const size_t &pos)
     {
-      std::shared_ptr<std::fstream> f(new std::fstream);
-      f->open(fd->path, fd->open_mode);
-      if(f->is_open())
+      uint16_t val;
+      char *ptr = reinterpret_cast<char *>(&val);
+      for(size_t i = 0; i < sizeof(val); i++)
         {
-          f->seekg(0, std::ios_base::end);
-          fd->file_size = static_cast<size_t>(f->tellg());
-          f->seekg(fd->start_offset, std::ios_base::beg);
-          fd->f = f;
-          result = ARCHIVE_OK;
+          ptr[i] = buf[pos + i];
         }
-      else
+      bo.setLittle(val);
+      val = bo;
+      return val;
+    };
+  auto get32 = [&bo](const std::string &buf, const size_t &pos)
+    {
+      uint32_t val;
+      char *ptr = reinterpret_cast<char *>(&val);
+      for(size_t i = 0; i < sizeof(val); i++)
         {
-          archive_set_error(a, ENOENT, "%s", "File has not been opened!");
+          ptr[i] = buf[pos + i];
         }
-    }
-  else
+      bo.setLittle(val);
+      val = bo;
+      return val;
+    };
+  auto set16 = [&bo](std::string &buf, const size_t &pos, uint16_t val)
     {
-      std::shared_ptr<std::stringstream> strm(new std::stringstream);
-      strm->str(fd->source_buffer);
-      strm->seekg(0, std::ios_base::end);
-      fd->file_size = static_cast<size_t>(strm->tellg());
+      bo = val;
+      bo.getLittle(val);
+      char *ptr = reinterpret_cast<char *>(&val);
+      for(size_t i = 0; i < sizeof(val); i++)
+        {
+          buf[pos + i] = ptr[i];
+        }
+    };
+  auto set32 = [&bo](std::string &buf, const size_t &pos, uint32_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      char *ptr = reinterpret_cast<char *>(&val);
+      for(size_t i = 0; i < sizeof(val); i++)
+        {
+          buf[pos + i] = ptr[i];
+        }
+    };
+
+  // End of central directory record: signature, comment length must reach
+  // end of file.
+  std::string eocd;
+  eocd.resize(22);
+  uint64_t eocd_offset = fsz - 22;
+  uint64_t search_lim = 0;
+  if(fsz > 65557)
+    {
+      search_lim = fsz - 65557;
+    }
+  for(;;)
+    {
+      f->seekg(eocd_offset, std::ios_base::beg);
+      f->read(eocd.data(), eocd.size());
+      if(!f->good())
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: error while reading archive");
+        }
+      if(get32(eocd, 0) == 101010256
+         && eocd_offset + 22 + get16(eocd, 20) == fsz)
+        {
+          break;
+        }
+      if(eocd_offset == search_lim)
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: not a zip file");
+        }
+      eocd_offset--;
+    }
+  eocd.resize(fsz - eocd_offset);
+  f->seekg(eocd_offset, std::ios_base::beg);
+  f->read(eocd.data(), eocd.size());
+  if(!f->good())
+    {
+      throw std::invalid_argument(
+          "LibArchive::removeFromZip: error while reading archive");
+    }
+
+  if(eocd_offset >= 20)
+    {
+      std::string locator;
+      locator.resize(4);
+      f->seekg(eocd_offset - 20, std::ios_base::beg);
+      f->read(locator.data(), locator.size());
+      if(!f->good())
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: error while reading archive");
+        }
+      if(get32(locator, 0) == 117853008)
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: zip64 archives are not supported");
+        }
+    }
+  if(get16(eocd, 4) != 0 || get16(eocd, 6) != 0
+     || get16(eocd, 8) != get16(eocd, 10))
+    {
+      throw std::invalid_argument(
+          "LibArchive::removeFromZip: multi-disk archives are not supported");
+    }
+
+  uint64_t cd_size = static_cast<uint64_t>(get32(eocd, 12));
+  uint64_t cd_offset = static_cast<uint64_t>(get32(eocd, 16));
+  if(cd_offset + cd_size > eocd_offset)
+    {
+      throw std::invalid_argument(
+          "LibArchive::removeFromZip: incorrect zip file");
+    }
+  std::string central_directory;
+  central_directory.resize(cd_size);
+  f->seekg(cd_offset, std::ios_base::beg);
+  f->read(central_directory.data(), central_directory.size());
+  if(!f->good())
+    {
+      throw std::invalid_argument(
+          "LibArchive::removeFromZip: error while reading archive");
+    }
+
+  std::vector<std::tuple<std::string, uint64_t, uint64_t>> list;
+  try
+    {
+      parseCentralDirectory(central_directory, list);
+    }
+  catch(std::exception &er)
+    {
+      throw std::invalid_argument(er.what());
+    }
+
+  // name, local header offset, central directory record, removal flag
+  std::vector<std::tuple<std::string, uint64_t, std::string, bool>> entries;
+  entries.reserve(list.size());
+  size_t rb = 0;
+  bool removal = false;
+  for(auto it = list.begin(); it != list.end(); it++)
+    {
+      if(rb + 46 > central_directory.size())
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: incorrect central directory");
+        }
+      size_t rec_sz
+          = 46 + static_cast<size_t>(get16(central_directory, rb + 28))
+            + static_cast<size_t>(get16(central_directory, rb + 30))
+            + static_cast<size_t>(get16(central_directory, rb + 32));
+      uint32_t offset = get32(central_directory, rb + 42);
+      if(offset == 0xffffffff || rb + rec_sz > central_directory.size())
+        {
+          throw std::invalid_argument(
+              "LibArchive::removeFromZip: zip64 archives are not supported");
+        }
+      bool remove = std::find(filenames.begin(), filenames.end(),
+                              std::get<0>(*it))
+                    != filenames.end();
+      if(remove)
+        {
+          removal = true;
+        }
+      entries.emplace_back(std::make_tuple(
+          std::get<0>(*it), static_cast<uint64_t>(offset),
+          central_directory.substr(rb, rec_sz), remove));
+      rb += rec_sz;
+    }
+  if(!removal)
+    {
+      return entries.size();
+    }
+
+  uint64_t new_cd_offset = cd_offset;
+  if(!keep_holes)
+    {
+      std::vector<size_t> order(entries.size());
+      for(size_t i = 0; i < order.size(); i++)
+        {
+          order[i] = i;
+        }
+      std::sort(order.begin(), order.end(),
+                [&entries](const size_t &el1, const size_t &el2)
+                  {
+                    return std::get<1>(entries[el1])
+                           < std::get<1>(entries[el2]);
+                  });
+
+      std::string buf;
+      buf.resize(4194304);
+      bool moving = false;
+      uint64_t write_pos = 0;
+      for(size_t i = 0; i < order.size(); i++)
+        {
+          std::tuple<std::string, uint64_t, std::string, bool> &entry
+              = entries[order[i]];
+          uint64_t start = std::get<1>(entry);
+          uint64_t end = cd_offset;
+          if(i + 1 < order.size())
+            {
+              end = std::get<1>(entries[order[i + 1]]);
+            }
+          if(std::get<3>(entry))
+            {
+              if(!moving)
+                {
+                  moving = true;
+                  write_pos = start;
+                }
+              continue;
+            }
+          if(!moving)
+            {
+              continue;
+            }
+          // Data is moved to lower offsets only, so copying from the start is
+          // safe.
+          for(uint64_t pos = start; pos < end;)
+            {
+              size_t sz = buf.size();
+              if(end - pos < sz)
+                {
+                  sz = static_cast<size_t>(end - pos);
+                }
+              f->seekg(pos, std::ios_base::beg);
+              f->read(buf.data(), sz);
+              if(!f->good())
+                {
+                  throw std::runtime_error(
+                      "LibArchive::removeFromZip: archive modification "
+                      "started, error while reading archive");
+                }
+              f->seekp(write_pos + (pos - start), std::ios_base::beg);
+              f->write(buf.data(), sz);
+              if(!f->good())
+                {
+                  throw std::runtime_error(
+                      "LibArchive::removeFromZip: archive modification "
+                      "started, error while writing archive");
+                }
+              pos += sz;
+            }
+          set32(std::get<2>(entry), 42, static_cast<uint32_t>(write_pos));
+          write_pos += end - start;
+        }
+      new_cd_offset = write_pos;
+    }
+
+  std::string new_cd;
+  uint16_t count = 0;
+  for(auto it = entries.begin(); it != entries.end(); it++)
+    {
+      if(!std::get<3>(*it))
+        {
+          new_cd += std::get<2>(*it);
+          count++;
+        }
+    }
+  set16(eocd, 8, count);
+  set16(eocd, 10, count);
+  set32(eocd, 12, static_cast<uint32_t>(new_cd.size()));
+  set32(eocd, 16, static_cast<uint32_t>(new_cd_offset));
+
+  f->seekp(new_cd_offset, std::ios_base::beg);
+  f->write(new_cd.c_str(), new_cd.size());
+  if(f->good())
+    {
+      f->write(eocd.c_str(), eocd.size());
+    }
+  f->close();
+  if(!f->good())
+    {
+      throw std::runtime_error("LibArchive::removeFromZip: archive "
+                               "modification started, error while writing "
+                               "archive");
+    }
+
+  std::filesystem::resize_file(archive_path,
+                               new_cd_offset + new_cd.size() + eocd.size());
+  mlbp->getArchiveCache()->removeArchive(archive_path);
+
+  return static_cast<size_t>(count);
+}
+
+void
+LibArchive::setCompressionThreads(const unsigned &threads)
+{
+  compression_threads = threads;
+  if(compression_threads == 0)
+    {
+      compression_threads = std::thread::hardware_concurrency();
+      if(compression_threads == 0)
+        {
+          compression_threads = 1;
+        }
+    }
+}
+
+std::shared_ptr<archive>
+LibArchive::initForReading(const std::shared_ptr<LibArchiveFileData> &fd)
+{
+  std::shared_ptr<archive> result(archive_read_new(),
+                                  [fd](archive *a)
+                                    {
+                                      archive_read_free(a);
+                                    });
+  int er = archive_read_support_filter_all(result.get());
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(result, "LibArchive::openForReading:");
+    }
+
+  er = archive_read_support_format_all(result.get());
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(result, "LibArchive::openForReading:");
+    }
+
+  return result;
+}
+
+std::shared_ptr<archive>
+LibArchive::initForWriting(const std::shared_ptr<LibArchiveFileData> &fd)
+{
+  std::shared_ptr<archive> result
+      = std::shared_ptr<archive>(archive_write_new(),
+                                 [](archive *a)
+                                   {
+                                     archive_free(a);
+                                   });
+
+  return result;
+}
+
+void
+LibArchive::archiveError(const std::shared_ptr<archive> &a,
+                         const std::string &message)
+{
+  const char *str = archive_error_string(a.get());
+  if(str)
+    {
+      std::string err = message + " \"" + str + "\"";
+      throw std::runtime_error(err);
+    }
+  else
+    {
+      std::string err = message + " " + std::strerror(archive_errno(a.get()));
+      throw std::runtime_error(err);
+    }
+}
+
+int
+LibArchive::openCallBack(archive *a, void *client_data)
+{
+  int result = ARCHIVE_FATAL;
+
+  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+  if(!fd->source_view.empty())
+    {
+      std::shared_ptr<LibArchiveMemoryStream> strm(new LibArchiveMemoryStream(
+          fd->source_view.data(), fd->source_view.size()));
+      fd->file_size = fd->source_view.size();
+      strm->seekg(fd->start_offset, std::ios_base::beg);
+      fd->f = strm;
+      result = ARCHIVE_OK;
+    }
+  else if(fd->source_buffer.empty())
+    {
+      std::shared_ptr<std::fstream> f(new std::fstream);
+      f->open(fd->path, fd->open_mode);
+      if(f->is_open())
+        {
+          f->seekg(0, std::ios_base::end);
+          fd->file_size = static_cast<size_t>(f->tellg());
+          f->seekg(fd->start_offset, std::ios_base::beg);
+          fd->f = f;
+          result = ARCHIVE_OK;
+        }
+      else
+        {
+          archive_set_error(a, ENOENT, "%s", "File has not been opened!");
+        }
+    }
+  else
+    {
+      std::shared_ptr<std::stringstream> strm(new std::stringstream);
+      strm->str(fd->source_buffer);
+      strm->seekg(0, std::ios_base::end);
+      fd->file_size = static_cast<size_t>(strm->tellg());
       strm->seekg(fd->start_offset, std::ios_base::beg);
       fd->f = strm;
       result = ARCHIVE_OK;
@@ -1095,7 +1648,16 @@ LibArchive::readCallBack(archive *a, void *client_data, const void **buffer)
 
   if(fd->f)
     {
-      if(fd->f->good())
+      if(fd->f->good() && !fd->source_view.empty())
+        {
+          // Memory buffer is passed to libarchive as is.
+          size_t rb = static_cast<size_t>(fd->f->tellg());
+          size_t left = fd->file_size - rb;
+          *buffer = fd->source_view.data() + rb;
+          result = static_cast<la_ssize_t>(left);
+          fd->f->seekg(static_cast<std::streamoff>(left), std::ios_base::cur);
+        }
+      else if(fd->f->good())
         {
           size_t rb = static_cast<size_t>(fd->f->tellg());
           size_t left = fd->file_size - rb;
@@ -1119,138 +1681,531 @@ LibArchive::readCallBack(archive *a, void *client_data, const void **buffer)
           archive_set_error(a, EIO, "%s", "Bad stream condition!");
         }
     }
-  else
-    {
-      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
-    }
-
-  return result;
+  else
+    {
+      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+    }
+
+  return result;
+}
+
+la_int64_t
+LibArchive::skipCallback(archive *a, void *client_data, la_int64_t request)
+{
+  la_int64_t result = 0;
+
+  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+
+  if(fd->f)
+    {
+      if(fd->f->good())
+        {
+          fd->f->seekg(request, std::ios_base::cur);
+          result = request;
+        }
+      else if(!fd->f->eof())
+        {
+          archive_set_error(a, EIO, "%s", "Bad stream condition!");
+        }
+    }
+  else
+    {
+      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+    }
+
+  return result;
+}
+
+int
+LibArchive::closeCallback(archive *a, void *client_data)
+{
+  int result = ARCHIVE_FATAL;
+
+  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+
+  if(fd->f)
+    {
+      fd->f.reset();
+      result = ARCHIVE_OK;
+    }
+  else
+    {
+      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+    }
+
+  return result;
+}
+
+la_int64_t
+LibArchive::seekCallback(archive *a, void *client_data, la_int64_t offset,
+                         int whence)
+{
+  la_int64_t result = 0;
+
+  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+
+  if(fd->f)
+    {
+      if(fd->f->good())
+        {
+          switch(whence)
+            {
+            case SEEK_SET:
+              {
+                fd->f->seekg(offset, std::ios_base::beg);
+                result = static_cast<la_int64_t>(fd->f->tellg());
+                break;
+              }
+            case SEEK_CUR:
+              {
+                fd->f->seekg(offset, std::ios_base::cur);
+                result = static_cast<la_int64_t>(fd->f->tellg());
+                break;
+              }
+            case SEEK_END:
+              {
+
+                fd->f->seekg(offset, std::ios_base::end);
+                result = static_cast<la_int64_t>(fd->f->tellg());
+                break;
+              }
+            default:
+              {
+                result = ARCHIVE_FATAL;
+                break;
+              }
+            }
+        }
+      else
+        {
+          archive_set_error(a, EIO, "%s", "Stream error!");
+        }
+    }
+  else
+    {
+      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+    }
+
+  return result;
+}
+
+la_ssize_t
+LibArchive::writeCallback(archive *a, void *client_data, const void *buffer,
+                          size_t length)
+{
+  la_ssize_t result = -1;
+  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+  if(fd != nullptr)
+    {
+      if(fd->f)
+        {
+          fd->f->write(reinterpret_cast<const char *>(buffer), length);
+          result = static_cast<la_ssize_t>(length);
+        }
+      else
+        {
+          archive_set_error(a, EPERM, "%s", "Cannot write to stream!");
+        }
+    }
+  else
+    {
+      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+    }
+
+  return result;
+}
+
+bool
+LibArchive::solidFormat(const std::shared_ptr<archive> &a)
+{
+  switch(archive_format(a.get()) & ARCHIVE_FORMAT_BASE_MASK)
+    {
+    case ARCHIVE_FORMAT_7ZIP:
+    case ARCHIVE_FORMAT_RAR:
+    case ARCHIVE_FORMAT_RAR_V5:
+      return true;
+    default:
+      return false;
+    }
+}
+
+bool
+LibArchive::cacheEntry(const std::shared_ptr<archive> &a,
+                       const std::shared_ptr<archive_entry> &e,
+                       const std::filesystem::path &archive_path,
+                       const std::shared_ptr<LibArchiveCache> &cache,
+                       size_t &read_ahead)
+{
+  // Entry following requested one is decoded only while read ahead budget
+  // allows it. Entries of unknown or too big size end read ahead.
+  if(archive_entry_filetype(e.get()) != AE_IFREG)
+    {
+      return true;
+    }
+  if(!archive_entry_size_is_set(e.get()))
+    {
+      return false;
+    }
+  la_int64_t sz = archive_entry_size(e.get());
+  if(sz <= 0)
+    {
+      return true;
+    }
+  if(static_cast<size_t>(sz) > read_ahead
+     || !cache->acceptable(static_cast<size_t>(sz)))
+    {
+      return false;
+    }
+  const char *val = archive_entry_pathname_utf8(e.get());
+  if(val == nullptr)
+    {
+      return true;
+    }
+
+  std::string buf = unpackEntryToBuffer(a, e);
+  cache->addEntry(archive_path, std::string(val), buf,
+                  getPermissionsFromEntry(e));
+  read_ahead -= static_cast<size_t>(sz);
+
+  return read_ahead > 0;
+}
+
+void
+LibArchive::unpackGroupToDirectories(
+    const std::filesystem::path &archive_path,
+    std::vector<std::tuple<std::string, std::filesystem::path, size_t>> &group,
+    std::vector<std::filesystem::path> &result)
+{
+  if(mlbp->fileFormat(archive_path) == MLBookProc::FileFormat::ZIP)
+    {
+      try
+        {
+          unpackZipGroupToDirectories(archive_path, group, result);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << er.what() << std::endl;
+        }
+      if(group.size() == 0)
+        {
+          return void();
+        }
+    }
+
+  std::shared_ptr<LibArchiveCache> cache = mlbp->getArchiveCache();
+  for(auto it = group.begin(); it != group.end();)
+    {
+      std::string buf;
+      std::filesystem::perms perms;
+      if(cache->getEntry(archive_path, std::get<0>(*it), buf, perms))
+        {
+          std::filesystem::path p
+              = std::get<1>(*it)
+                / std::u8string(std::get<0>(*it).begin(),
+                                std::get<0>(*it).end());
+          std::filesystem::create_directories(p.parent_path());
+          bufferToFile(buf, p, perms);
+          result[std::get<2>(*it)] = p;
+          it = group.erase(it);
+        }
+      else
+        {
+          it++;
+        }
+    }
+  if(group.size() == 0)
+    {
+      return void();
+    }
+
+  std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
+  fd->path = archive_path;
+  fd->open_mode = std::ios_base::in | std::ios_base::binary;
+
+  std::shared_ptr<archive> a = initForReading(fd);
+
+  int er = archive_read_set_seek_callback(a.get(), &LibArchive::seekCallback);
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(a, "LibArchive::unpackGroupToDirectories:");
+    }
+
+  er = archive_read_open2(a.get(), fd.get(), &LibArchive::openCallBack,
+                          &LibArchive::readCallBack, &LibArchive::skipCallback,
+                          &LibArchive::closeCallback);
+  if(er != ARCHIVE_OK)
+    {
+      archiveError(a, "LibArchive::unpackGroupToDirectories:");
+    }
+
+  std::shared_ptr<archive_entry> e(archive_entry_new(),
+                                   [](archive_entry *e)
+                                     {
+                                       archive_entry_free(e);
+                                     });
+  int retry_count = 0;
+  size_t read_ahead = 0;
+  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3
+        && (group.size() > 0 || read_ahead > 0))
+    {
+      er = archive_read_next_header2(a.get(), e.get());
+      switch(er)
+        {
+        case ARCHIVE_WARN:
+          {
+            const char *str = archive_error_string(a.get());
+            std::string err;
+            if(str)
+              {
+                err = std::string("LibArchive::unpackGroupToDirectories: \"")
+                      + str + "\"";
+              }
+            else
+              {
+                err = std::string("LibArchive::unpackGroupToDirectories: ")
+                      + std::strerror(archive_errno(a.get()));
+              }
+            std::cout << err << std::endl;
+          }
+        case ARCHIVE_OK:
+          {
+            retry_count = 0;
+            const char *val = archive_entry_pathname_utf8(e.get());
+            if(val == nullptr)
+              {
+                break;
+              }
+            std::string name(val);
+            bool solid = solidFormat(a);
+            bool requested = false;
+            std::string buf;
+            for(auto it = group.begin(); it != group.end();)
+              {
+                if(std::get<0>(*it) != name)
+                  {
+                    it++;
+                    continue;
+                  }
+                std::filesystem::path p
+                    = std::get<1>(*it)
+                      / std::u8string(reinterpret_cast<const char8_t *>(val));
+                std::filesystem::create_directories(p.parent_path());
+                if(archive_entry_filetype(e.get()) == AE_IFREG)
+                  {
+                    if(!requested)
+                      {
+                        buf = unpackEntryToBuffer(a, e);
+                        if(solid)
+                          {
+                            cache->addEntry(archive_path, name, buf,
+                                            getPermissionsFromEntry(e));
+                          }
+                        requested = true;
+                      }
+                    bufferToFile(buf, p, getPermissionsFromEntry(e));
+                  }
+                else
+                  {
+                    unpackEntryToDirectory(a, e, p);
+                  }
+                result[std::get<2>(*it)] = p;
+                it = group.erase(it);
+              }
+            if(requested)
+              {
+                if(group.size() == 0 && solid)
+                  {
+                    read_ahead = cache->getCacheSize() / 4;
+                  }
+              }
+            else if(group.size() == 0)
+              {
+                if(!cacheEntry(a, e, archive_path, cache, read_ahead))
+                  {
+                    read_ahead = 0;
+                  }
+              }
+            break;
+          }
+        case ARCHIVE_EOF:
+          {
+            break;
+          }
+        case ARCHIVE_RETRY:
+          {
+            retry_count++;
+            break;
+          }
+        default:
+          {
+            archiveError(a, "LibArchive::unpackGroupToDirectories:");
+            break;
+          }
+        }
+      archive_entry_clear(e.get());
+    }
 }
 
-la_int64_t
-LibArchive::skipCallback(archive *a, void *client_data, la_int64_t request)
+void
+LibArchive::unpackZipGroupToDirectories(
+    const std::filesystem::path &archive_path,
+    std::vector<std::tuple<std::string, std::filesystem::path, size_t>> &group,
+    std::vector<std::filesystem::path> &result)
 {
-  la_int64_t result = 0;
-
-  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
-
-  if(fd->f)
-    {
-      if(fd->f->good())
-        {
-          fd->f->seekg(request, std::ios_base::cur);
-          result = request;
-        }
-      else if(!fd->f->eof())
+  std::vector<std::tuple<std::string, uint64_t, uint64_t>> list;
+  listFilesInZipCentralDirectory(archive_path, list);
+
+  // Archive is read in single stream starting from the first requested
+  // local header. Entries between requested ones are skipped by seeking.
+  bool offset_found = false;
+  uint64_t first_offset = 0;
+  for(auto it = group.begin(); it != group.end(); it++)
+    {
+      std::string name = std::get<0>(*it);
+      auto it_l = std::find_if(
+          list.begin(), list.end(),
+          [name](const std::tuple<std::string, uint64_t, uint64_t> &el)
+            {
+              return std::get<0>(el) == name;
+            });
+      if(it_l != list.end())
         {
-          archive_set_error(a, EIO, "%s", "Bad stream condition!");
+          if(!offset_found || std::get<2>(*it_l) < first_offset)
+            {
+              first_offset = std::get<2>(*it_l);
+              offset_found = true;
+            }
         }
     }
-  else
+  if(!offset_found)
     {
-      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+      return void();
     }
 
-  return result;
-}
-
-int
-LibArchive::closeCallback(archive *a, void *client_data)
-{
-  int result = ARCHIVE_FATAL;
+  std::shared_ptr<LibArchiveFileData> fd(new LibArchiveFileData);
+  fd->path = archive_path;
+  fd->open_mode = std::ios_base::in | std::ios_base::binary;
+  fd->start_offset = static_cast<size_t>(first_offset);
 
-  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
+  std::shared_ptr<archive> a = initForReading(fd);
 
-  if(fd->f)
-    {
-      fd->f.reset();
-      result = ARCHIVE_OK;
-    }
-  else
+  int er = archive_read_open2(a.get(), fd.get(), &LibArchive::openCallBack,
+                              &LibArchive::readCallBack,
+                              &LibArchive::skipCallback,
+                              &LibArchive::closeCallback);
+  if(er != ARCHIVE_OK)
     {
-      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+      archiveError(a, "LibArchive::unpackZipGroupToDirectories:");
     }
 
-  return result;
-}
-
-la_int64_t
-LibArchive::seekCallback(archive *a, void *client_data, la_int64_t offset,
-                         int whence)
-{
-  la_int64_t result = 0;
-
-  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
-
-  if(fd->f)
+  std::shared_ptr<archive_entry> e(archive_entry_new(),
+                                   [](archive_entry *e)
+                                     {
+                                       archive_entry_free(e);
+                                     });
+  int retry_count = 0;
+  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3
+        && group.size() > 0)
     {
-      if(fd->f->good())
+      er = archive_read_next_header2(a.get(), e.get());
+      switch(er)
         {
-          switch(whence)
-            {
-            case SEEK_SET:
+        case ARCHIVE_WARN:
+          {
+            const char *str = archive_error_string(a.get());
+            std::string err;
+            if(str)
               {
-                fd->f->seekg(offset, std::ios_base::beg);
-                result = static_cast<la_int64_t>(fd->f->tellg());
-                break;
+                err = std::string("LibArchive::unpackZipGroupToDirectories: "
+                                  "\"")
+                      + str + "\"";
               }
-            case SEEK_CUR:
+            else
               {
-                fd->f->seekg(offset, std::ios_base::cur);
-                result = static_cast<la_int64_t>(fd->f->tellg());
-                break;
+                err = std::string("LibArchive::unpackZipGroupToDirectories: ")
+                      + std::strerror(archive_errno(a.get()));
               }
-            case SEEK_END:
+            std::cout << err << std::endl;
+          }
+        case ARCHIVE_OK:
+          {
+            retry_count = 0;
+            const char *val = archive_entry_pathname_utf8(e.get());
+            if(val == nullptr)
               {
-
-                fd->f->seekg(offset, std::ios_base::end);
-                result = static_cast<la_int64_t>(fd->f->tellg());
                 break;
               }
-            default:
+            std::string name(val);
+            std::filesystem::path unpacked;
+            for(auto it = group.begin(); it != group.end();)
               {
-                result = ARCHIVE_FATAL;
-                break;
+                if(std::get<0>(*it) != name)
+                  {
+                    it++;
+                    continue;
+                  }
+                std::filesystem::path p
+                    = std::get<1>(*it)
+                      / std::u8string(reinterpret_cast<const char8_t *>(val));
+                std::filesystem::create_directories(p.parent_path());
+                if(unpacked.empty()
+                   || archive_entry_filetype(e.get()) != AE_IFREG)
+                  {
+                    unpackEntryToDirectory(a, e, p);
+                    unpacked = p;
+                  }
+                else if(p != unpacked)
+                  {
+                    std::filesystem::copy_file(
+                        unpacked, p,
+                        std::filesystem::copy_options::overwrite_existing);
+                  }
+                result[std::get<2>(*it)] = p;
+                it = group.erase(it);
               }
-            }
-        }
-      else
-        {
-          archive_set_error(a, EIO, "%s", "Stream error!");
+            break;
+          }
+        case ARCHIVE_EOF:
+          {
+            break;
+          }
+        case ARCHIVE_RETRY:
+          {
+            retry_count++;
+            break;
+          }
+        default:
+          {
+            archiveError(a, "LibArchive::unpackZipGroupToDirectories:");
+            break;
+          }
         }
+      archive_entry_clear(e.get());
     }
-  else
-    {
-      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
-    }
-
-  return result;
 }
 
-la_ssize_t
-LibArchive::writeCallback(archive *a, void *client_data, const void *buffer,
-                          size_t length)
+void
+LibArchive::bufferToFile(const std::string &buf,
+                         const std::filesystem::path &file_path,
+                         const std::filesystem::perms &perms)
 {
-  la_ssize_t result = -1;
-  LibArchiveFileData *fd = reinterpret_cast<LibArchiveFileData *>(client_data);
-  if(fd != nullptr)
+  std::fstream f;
+  f.open(file_path, std::ios_base::out | std::ios_base::binary);
+  if(!f.is_open())
     {
-      if(fd->f)
-        {
-          fd->f->write(reinterpret_cast<const char *>(buffer), length);
-          result = static_cast<la_ssize_t>(length);
-        }
-      else
-        {
-          archive_set_error(a, EPERM, "%s", "Cannot write to stream!");
-        }
+      std::cout << "LibArchive::bufferToFile: cannot create file "
+                << file_path << std::endl;
+      return void();
     }
-  else
+  f.write(buf.c_str(), buf.size());
+  f.close();
+
+  std::error_code ec;
+  std::filesystem::permissions(file_path, perms, ec);
+  if(ec)
     {
-      archive_set_error(a, EINVAL, "%s", "Stream object is null!");
+      std::cout << "LibArchive::bufferToFile: " << ec.message() << std::endl;
     }
-
-  return result;
 }
 
 void
@@ -1790,6 +2745,23 @@ LibArchive::unpackToDirectory(std::shared_ptr<LibArchiveFileData> fd,
                               const std::filesystem::path &directory)
 {
   std::filesystem::path result;
+
+  std::shared_ptr<LibArchiveCache> cache;
+  if(fd->source_buffer.empty() && fd->source_view.empty())
+    {
+      cache = mlbp->getArchiveCache();
+      std::string buf;
+      std::filesystem::perms perms;
+      if(cache->getEntry(fd->path, filename, buf, perms))
+        {
+          result = directory
+                   / std::u8string(filename.begin(), filename.end());
+          std::filesystem::create_directories(result.parent_path());
+          bufferToFile(buf, result, perms);
+          return result;
+        }
+    }
+
   std::shared_ptr<archive> a = initForReading(fd);
 
   int er;
@@ -1817,7 +2789,10 @@ LibArchive::unpackToDirectory(std::shared_ptr<LibArchiveFileData> fd,
                                        archive_entry_free(e);
                                      });
   int retry_count = 0;
-  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3)
+  bool found = false;
+  size_t read_ahead = 0;
+  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3
+        && (!found || read_ahead > 0))
     {
       er = archive_read_next_header2(a.get(), e.get());
       switch(er)
@@ -1844,7 +2819,7 @@ LibArchive::unpackToDirectory(std::shared_ptr<LibArchiveFileData> fd,
             const char *val = archive_entry_pathname_utf8(e.get());
             if(val)
               {
-                if(std::string(val) == filename)
+                if(!found && std::string(val) == filename)
                   {
 
                     result = directory
@@ -1852,9 +2827,35 @@ LibArchive::unpackToDirectory(std::shared_ptr<LibArchiveFileData> fd,
                                  reinterpret_cast<const char8_t *>(val));
                     std::filesystem::create_directories(result.parent_path());
 
-                    unpackEntryToDirectory(a, e, result);
+                    bool solid = cache && solidFormat(a);
+                    if(solid && archive_entry_filetype(e.get()) == AE_IFREG
+                       && archive_entry_size_is_set(e.get())
+                       && cache->acceptable(
+                           static_cast<size_t>(archive_entry_size(e.get()))))
+                      {
+                        std::string buf = unpackEntryToBuffer(a, e);
+                        std::filesystem::perms perms
+                            = getPermissionsFromEntry(e);
+                        cache->addEntry(fd->path, filename, buf, perms);
+                        bufferToFile(buf, result, perms);
+                      }
+                    else
+                      {
+                        unpackEntryToDirectory(a, e, result);
+                      }
 
-                    retry_count = 3;
+                    found = true;
+                    if(solid)
+                      {
+                        read_ahead = cache->getCacheSize() / 4;
+                      }
+                  }
+                else if(found)
+                  {
+                    if(!cacheEntry(a, e, fd->path, cache, read_ahead))
+                      {
+                        read_ahead = 0;
+                      }
                   }
               }
             break;
@@ -1884,6 +2885,17 @@ void
 LibArchive::unpackToBuffer(std::shared_ptr<LibArchiveFileData> fd,
                            const std::string &filename, std::string &result)
 {
+  std::shared_ptr<LibArchiveCache> cache;
+  if(fd->source_buffer.empty() && fd->source_view.empty())
+    {
+      cache = mlbp->getArchiveCache();
+      std::filesystem::perms perms;
+      if(cache->getEntry(fd->path, filename, result, perms))
+        {
+          return void();
+        }
+    }
+
   std::shared_ptr<archive> a = initForReading(fd);
 
   int er;
@@ -1911,7 +2923,10 @@ LibArchive::unpackToBuffer(std::shared_ptr<LibArchiveFileData> fd,
                                        archive_entry_free(e);
                                      });
   int retry_count = 0;
-  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3)
+  bool found = false;
+  size_t read_ahead = 0;
+  while(er >= ARCHIVE_WARN && er <= ARCHIVE_OK && retry_count < 3
+        && (!found || read_ahead > 0))
     {
       er = archive_read_next_header2(a.get(), e.get());
       switch(er)
@@ -1938,10 +2953,23 @@ LibArchive::unpackToBuffer(std::shared_ptr<LibArchiveFileData> fd,
             const char *val = archive_entry_pathname_utf8(e.get());
             if(val)
               {
-                if(std::string(val) == filename)
+                if(!found && std::string(val) == filename)
                   {
                     result = unpackEntryToBuffer(a, e);
-                    retry_count = 3;
+                    found = true;
+                    if(cache && solidFormat(a))
+                      {
+                        cache->addEntry(fd->path, filename, result,
+                                        getPermissionsFromEntry(e));
+                        read_ahead = cache->getCacheSize() / 4;
+                      }
+                  }
+                else if(found)
+                  {
+                    if(!cacheEntry(a, e, fd->path, cache, read_ahead))
+                      {
+                        read_ahead = 0;
+                      }
                   }
               }
             break;
@@ -2159,7 +3187,8 @@ void
 LibArchive::writeFile(std::shared_ptr<archive> a,
                       const std::filesystem::path &path,
                       std::string name_in_archive,
-                      const std::filesystem::perms &perms)
+                      const std::filesystem::perms &perms,
+                      std::shared_ptr<LibArchiveZipWriter> zip_writer)
 {
   std::shared_ptr<archive_entry> e(archive_entry_new(),
                                    [](archive_entry *e)
@@ -2208,6 +3237,23 @@ LibArchive::writeFile(std::shared_ptr<archive> a,
 
   setUsernameGroupname(e);
 
+  if(zip_writer)
+    {
+      std::fstream f;
+      f.open(path, std::ios_base::in | std::ios_base::binary);
+      if(!f.is_open())
+        {
+          throw std::runtime_error(
+              "LibArchive::writeFile: cannot open source file");
+        }
+      std::string buf;
+      buf.resize(static_cast<size_t>(archive_entry_size(e.get())));
+      f.read(buf.data(), buf.size());
+      f.close();
+      zip_writer->addEntry(e, std::move(buf));
+      return void();
+    }
+
   int er = archive_write_header(a.get(), e.get());
   if(er != ARCHIVE_OK)
     {
@@ -2542,6 +3588,89 @@ LibArchive::writeBufferToArchive(std::shared_ptr<archive> a,
     }
 }
 
+std::shared_ptr<LibArchiveZipWriter>
+LibArchive::setWriteThreads(std::shared_ptr<archive> &a,
+                            const std::shared_ptr<LibArchiveFileData> &fd)
+{
+  std::shared_ptr<LibArchiveZipWriter> result;
+  if(compression_threads < 2)
+    {
+      return result;
+    }
+
+  if(archive_format(a.get()) == ARCHIVE_FORMAT_ZIP)
+    {
+      // libarchive zip writer compresses entries one by one, so entries are
+      // compressed separately and merged by LibArchiveZipWriter.
+      a.reset();
+      result = std::make_shared<LibArchiveZipWriter>(fd, compression_threads);
+      return result;
+    }
+
+  std::string threads = std::to_string(compression_threads);
+  for(int i = 0; i < archive_filter_count(a.get()); i++)
+    {
+      const char *module = nullptr;
+      switch(archive_filter_code(a.get(), i))
+        {
+        case ARCHIVE_FILTER_XZ:
+          {
+            module = "xz";
+            break;
+          }
+        case ARCHIVE_FILTER_ZSTD:
+          {
+            module = "zstd";
+            break;
+          }
+        default:
+          break;
+        }
+      if(module == nullptr)
+        {
+          continue;
+        }
+      int er = archive_write_set_filter_option(a.get(), module, "threads",
+                                               threads.c_str());
+      if(er != ARCHIVE_OK)
+        {
+          try
+            {
+              archiveError(a, "LibArchive::setWriteThreads:");
+            }
+          catch(std::exception &ex)
+            {
+              std::cout << ex.what() << std::endl;
+            }
+        }
+    }
+
+  return result;
+}
+
+void
+LibArchive::writeEntry(std::shared_ptr<archive> a,
+                       std::shared_ptr<LibArchiveZipWriter> zip_writer,
+                       std::shared_ptr<archive_entry> e, std::string &buf)
+{
+  if(zip_writer)
+    {
+      zip_writer->addEntry(e, std::move(buf));
+    }
+  else if(buf.size() > 0)
+    {
+      writeBufferToArchive(a, e, buf);
+    }
+  else
+    {
+      int er = archive_write_header(a.get(), e.get());
+      if(er != ARCHIVE_OK)
+        {
+          archiveError(a, "LibArchive::writeEntry:");
+        }
+    }
+}
+
 std::filesystem::perms
 LibArchive::getPermissionsFromEntry(const std::shared_ptr<archive_entry> &e)
 {
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <LibArchiveCache.h>
+#include <algorithm>
+
+LibArchiveCache::LibArchiveCache()
+{
+}
+
+LibArchiveCache::~LibArchiveCache()
+{
+}
+
+void
+LibArchiveCache::setCacheSize(const size_t &cache_size)
+{
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  this->cache_size = cache_size;
+  shrink();
+}
+
+size_t
+LibArchiveCache::getCacheSize()
+{
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  return cache_size;
+}
+
+bool
+LibArchiveCache::getEntry(const std::filesystem::path &archive_path,
+                          const std::string &entry_name, std::string &result,
+                          std::filesystem::perms &perms)
+{
+  std::filesystem::file_time_type mtime;
+  uintmax_t fsz;
+  if(!archiveStamp(archive_path, mtime, fsz))
+    {
+      return false;
+    }
+
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  auto it = std::find_if(
+      cache.begin(), cache.end(),
+      [archive_path, entry_name](
+          const std::tuple<std::filesystem::path,
+                           std::filesystem::file_time_type, uintmax_t,
+                           std::string, std::string, std::filesystem::perms>
+              &el)
+        {
+          return std::get<3>(el) == entry_name
+                 && std::get<0>(el) == archive_path;
+        });
+  if(it == cache.end())
+    {
+      return false;
+    }
+  if(std::get<1>(*it) != mtime || std::get<2>(*it) != fsz)
+    {
+      current_size -= std::get<4>(*it).size();
+      cache.erase(it);
+      return false;
+    }
+
+  result = std::get<4>(*it);
+  perms = std::get<5>(*it);
+  cache.splice(cache.begin(), cache, it);
+
+  return true;
+}
+
+void
+LibArchiveCache::addEntry(const std::filesystem::path &archive_path,
+                          const std::string &entry_name,
+                          const std::string &content,
+                          const std::filesystem::perms &perms)
+{
+  if(!acceptable(content.size()))
+    {
+      return void();
+    }
+
+  std::filesystem::file_time_type mtime;
+  uintmax_t fsz;
+  if(!archiveStamp(archive_path, mtime, fsz))
+    {
+      return void();
+    }
+
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  auto it = std::find_if(
+      cache.begin(), cache.end(),
+      [archive_path, entry_name](
+          const std::tuple<std::filesystem::path,
+                           std::filesystem::file_time_type, uintmax_t,
+                           std::string, std::string, std::filesystem::perms>
+              &el)
+        {
+          return std::get<3>(el) == entry_name
+                 && std::get<0>(el) == archive_path;
+        });
+  if(it != cache.end())
+    {
+      current_size -= std::get<4>(*it).size();
+      cache.erase(it);
+    }
+
+  cache.emplace_front(
+      std::make_tuple(archive_path, mtime, fsz, entry_name, content, perms));
+  current_size += content.size();
+
+  shrink();
+}
+
+bool
+LibArchiveCache::acceptable(const size_t &entry_size)
+{
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  return entry_size > 0 && entry_size <= cache_size / 4;
+}
+
+void
+LibArchiveCache::removeArchive(const std::filesystem::path &archive_path)
+{
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  for(auto it = cache.begin(); it != cache.end();)
+    {
+      if(std::get<0>(*it) == archive_path)
+        {
+          current_size -= std::get<4>(*it).size();
+          it = cache.erase(it);
+        }
+      else
+        {
+          it++;
+        }
+    }
+}
+
+void
+LibArchiveCache::clear()
+{
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  cache.clear();
+  current_size = 0;
+}
+
+bool
+LibArchiveCache::archiveStamp(const std::filesystem::path &archive_path,
+                              std::filesystem::file_time_type &mtime,
+                              uintmax_t &fsz)
+{
+  std::error_code ec;
+  mtime = std::filesystem::last_write_time(archive_path, ec);
+  if(ec)
+    {
+      return false;
+    }
+  fsz = std::filesystem::file_size(archive_path, ec);
+  if(ec)
+    {
+      return false;
+    }
+
+  return true;
+}
+
+void
+LibArchiveCache::shrink()
+{
+  while(current_size > cache_size && cache.size() > 0)
+    {
+      current_size -= std::get<4>(*cache.rbegin()).size();
+      cache.pop_back();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <LibArchiveMemoryStream.h>
+
+LibArchiveMemoryStream::LibArchiveMemoryStream(const char *data,
+                                               const size_t &size)
+    : std::iostream(nullptr), memory_buffer(data, size)
+{
+  rdbuf(&memory_buffer);
+}
+
+LibArchiveMemoryStream::~LibArchiveMemoryStream()
+{
+}
+
+LibArchiveMemoryStream::MemoryBuffer::MemoryBuffer(const char *data,
+                                                   const size_t &size)
+{
+  // Buffer is never written, get area just needs non-const pointers.
+  char *begin = const_cast<char *>(data);
+  setg(begin, begin, begin + size);
+}
+
+LibArchiveMemoryStream::MemoryBuffer::pos_type
+LibArchiveMemoryStream::MemoryBuffer::seekoff(off_type off,
+                                              std::ios_base::seekdir dir,
+                                              std::ios_base::openmode which)
+{
+  if(!(which & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+
+  off_type pos;
+  switch(dir)
+    {
+    case std::ios_base::beg:
+      {
+        pos = off;
+        break;
+      }
+    case std::ios_base::cur:
+      {
+        pos = static_cast<off_type>(gptr() - eback()) + off;
+        break;
+      }
+    case std::ios_base::end:
+      {
+        pos = static_cast<off_type>(egptr() - eback()) + off;
+        break;
+      }
+    default:
+      {
+        return pos_type(off_type(-1));
+      }
+    }
+
+  if(pos < 0 || pos > static_cast<off_type>(egptr() - eback()))
+    {
+      return pos_type(off_type(-1));
+    }
+
+  setg(eback(), eback() + pos, egptr());
+
+  return pos_type(pos);
+}
+
+LibArchiveMemoryStream::MemoryBuffer::pos_type
+LibArchiveMemoryStream::MemoryBuffer::seekpos(pos_type pos,
+                                              std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
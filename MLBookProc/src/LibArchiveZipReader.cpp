@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <LibArchiveZipReader.h>
+
+LibArchiveZipReader::LibArchiveZipReader(LibArchive *arch,
+                                         const std::string &buffer)
+{
+  this->arch = arch;
+  this->buffer = &buffer;
+
+  arch->listFilesInZipBuffer(buffer, file_list);
+  file_index.reserve(file_list.size());
+  for(size_t i = 0; i < file_list.size(); i++)
+    {
+      file_index.emplace(std::get<0>(file_list[i]), i);
+    }
+}
+
+const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &
+LibArchiveZipReader::files() const
+{
+  return file_list;
+}
+
+bool
+LibArchiveZipReader::contains(const std::string &filename) const
+{
+  return file_index.find(filename) != file_index.end();
+}
+
+std::string
+LibArchiveZipReader::unpack(const std::string &filename) const
+{
+  std::string result;
+
+  auto it = file_index.find(filename);
+  if(it != file_index.end())
+    {
+      result = arch->unpackBufferFileToBuffer(
+          *buffer, filename,
+          static_cast<size_t>(std::get<2>(file_list[it->second])));
+    }
+
+  return result;
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <ByteOrder.h>
+#include <LibArchiveZipWriter.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+LibArchiveZipWriter::LibArchiveZipWriter(
+    const std::shared_ptr<LibArchiveFileData> &fd, const unsigned &threads)
+{
+  this->fd = fd;
+  this->threads = threads;
+  if(this->threads == 0)
+    {
+      this->threads = 1;
+    }
+
+  std::shared_ptr<std::fstream> f(new std::fstream);
+  f->open(fd->path, fd->open_mode);
+  if(!f->is_open())
+    {
+      std::string err = "LibArchiveZipWriter::LibArchiveZipWriter: cannot "
+                        "open file ";
+      std::u8string u8str = fd->path.u8string();
+      err += std::string(u8str.begin(), u8str.end());
+      throw std::runtime_error(err);
+    }
+  fd->f = f;
+}
+
+LibArchiveZipWriter::~LibArchiveZipWriter()
+{
+}
+
+void
+LibArchiveZipWriter::addEntry(const std::shared_ptr<archive_entry> &e,
+                              std::string buf)
+{
+  std::shared_ptr<archive_entry> entry(archive_entry_clone(e.get()),
+                                       [](archive_entry *e)
+                                         {
+                                           archive_entry_free(e);
+                                         });
+  if(archive_entry_filetype(entry.get()) == AE_IFREG)
+    {
+      archive_entry_set_size(entry.get(), static_cast<la_int64_t>(buf.size()));
+    }
+  batch_size += buf.size();
+  batch.emplace_back(std::make_tuple(entry, std::move(buf)));
+  if(batch_size >= static_cast<size_t>(threads) * 4194304
+     || batch.size() >= static_cast<size_t>(threads) * 8)
+    {
+      flush();
+    }
+}
+
+void
+LibArchiveZipWriter::finish()
+{
+  flush();
+  if(!fd->f)
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::finish: output stream is closed");
+    }
+
+  ByteOrder bo;
+  auto set16 = [&bo](std::string &buf, const size_t &pos, uint16_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+  auto set32 = [&bo](std::string &buf, const size_t &pos, uint32_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+  auto set64 = [&bo](std::string &buf, const size_t &pos, uint64_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+
+  uint64_t cd_offset = offset;
+  uint64_t cd_size = static_cast<uint64_t>(central_directory.size());
+  fd->f->write(central_directory.c_str(), central_directory.size());
+
+  if(entries >= 0xffff || cd_offset >= 0xffffffff || cd_size >= 0xffffffff)
+    {
+      // Zip64 end of central directory record and its locator.
+      std::string record(56, 0);
+      set32(record, 0, 101075792);
+      set64(record, 4, 44);
+      set16(record, 12, 45);
+      set16(record, 14, 45);
+      set64(record, 24, entries);
+      set64(record, 32, entries);
+      set64(record, 40, cd_size);
+      set64(record, 48, cd_offset);
+
+      std::string locator(20, 0);
+      set32(locator, 0, 117853008);
+      set64(locator, 8, cd_offset + cd_size);
+      set32(locator, 16, 1);
+
+      fd->f->write(record.c_str(), record.size());
+      fd->f->write(locator.c_str(), locator.size());
+    }
+
+  std::string eocd(22, 0);
+  set32(eocd, 0, 101010256);
+  uint16_t count = 0xffff;
+  if(entries < 0xffff)
+    {
+      count = static_cast<uint16_t>(entries);
+    }
+  set16(eocd, 8, count);
+  set16(eocd, 10, count);
+  set32(eocd, 12,
+        static_cast<uint32_t>(std::min(cd_size, uint64_t(0xffffffff))));
+  set32(eocd, 16,
+        static_cast<uint32_t>(std::min(cd_offset, uint64_t(0xffffffff))));
+  fd->f->write(eocd.c_str(), eocd.size());
+
+  bool good = fd->f->good();
+  fd->f.reset();
+  if(!good)
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::finish: error while writing archive");
+    }
+}
+
+void
+LibArchiveZipWriter::flush()
+{
+  if(batch.size() == 0)
+    {
+      return void();
+    }
+
+  std::vector<std::string> result(batch.size());
+  std::vector<std::string> errors(batch.size());
+#pragma omp parallel for schedule(dynamic) num_threads(static_cast<int>(threads))
+  for(size_t i = 0; i < batch.size(); i++)
+    {
+      try
+        {
+          result[i] = compressEntry(std::get<0>(batch[i]),
+                                    std::get<1>(batch[i]));
+        }
+      catch(std::exception &er)
+        {
+          errors[i] = er.what();
+        }
+    }
+  batch.clear();
+  batch_size = 0;
+
+  for(size_t i = 0; i < result.size(); i++)
+    {
+      if(!errors[i].empty())
+        {
+          throw std::runtime_error(errors[i]);
+        }
+      appendEntry(result[i]);
+      result[i].clear();
+      result[i].shrink_to_fit();
+    }
+}
+
+std::string
+LibArchiveZipWriter::compressEntry(const std::shared_ptr<archive_entry> &e,
+                                   const std::string &buf)
+{
+  std::string result;
+
+  std::shared_ptr<archive> a(archive_write_new(),
+                             [](archive *a)
+                               {
+                                 archive_free(a);
+                               });
+  auto error = [a]()
+    {
+      std::string err = "LibArchiveZipWriter::compressEntry:";
+      const char *str = archive_error_string(a.get());
+      if(str)
+        {
+          err += std::string(" \"") + str + "\"";
+        }
+      else
+        {
+          err += std::string(" ") + std::strerror(archive_errno(a.get()));
+        }
+      throw std::runtime_error(err);
+    };
+
+  if(archive_write_set_format_zip(a.get()) != ARCHIVE_OK)
+    {
+      error();
+    }
+  if(archive_write_set_bytes_per_block(a.get(), 0) != ARCHIVE_OK)
+    {
+      error();
+    }
+  archive_write_set_options(a.get(), "hdrcharset=UTF-8");
+  if(archive_write_open(a.get(), &result, nullptr,
+                        &LibArchiveZipWriter::writeCallback, nullptr)
+     != ARCHIVE_OK)
+    {
+      error();
+    }
+
+  if(archive_write_header(a.get(), e.get()) != ARCHIVE_OK)
+    {
+      error();
+    }
+  la_ssize_t wb;
+  size_t pos = 0;
+  while(pos < buf.size())
+    {
+      wb = archive_write_data(
+          a.get(), reinterpret_cast<const void *>(buf.c_str() + pos),
+          buf.size() - pos);
+      if(wb <= 0)
+        {
+          error();
+        }
+      pos += static_cast<size_t>(wb);
+    }
+  if(archive_write_close(a.get()) != ARCHIVE_OK)
+    {
+      error();
+    }
+
+  return result;
+}
+
+void
+LibArchiveZipWriter::appendEntry(const std::string &zip)
+{
+  ByteOrder bo;
+  auto get16 = [&bo](const std::string &buf, const size_t &pos)
+    {
+      uint16_t val;
+      std::memcpy(&val, buf.c_str() + pos, sizeof(val));
+      bo.setLittle(val);
+      val = bo;
+      return val;
+    };
+  auto get32 = [&bo](const std::string &buf, const size_t &pos)
+    {
+      uint32_t val;
+      std::memcpy(&val, buf.c_str() + pos, sizeof(val));
+      bo.setLittle(val);
+      val = bo;
+      return val;
+    };
+  auto set16 = [&bo](std::string &buf, const size_t &pos, uint16_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+  auto set32 = [&bo](std::string &buf, const size_t &pos, uint32_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+  auto set64 = [&bo](std::string &buf, const size_t &pos, uint64_t val)
+    {
+      bo = val;
+      bo.getLittle(val);
+      std::memcpy(buf.data() + pos, &val, sizeof(val));
+    };
+
+  if(zip.size() < 22 || get32(zip, zip.size() - 22) != 101010256)
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::appendEntry: incorrect entry");
+    }
+  size_t eocd = zip.size() - 22;
+  size_t cd_size = static_cast<size_t>(get32(zip, eocd + 12));
+  size_t cd_offset = static_cast<size_t>(get32(zip, eocd + 16));
+  if(get16(zip, eocd + 10) != 1 || cd_size < 46
+     || cd_offset + cd_size > eocd)
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::appendEntry: incorrect entry");
+    }
+
+  std::string record = zip.substr(cd_offset, cd_size);
+  if(offset < 0xffffffff)
+    {
+      set32(record, 42, static_cast<uint32_t>(offset));
+    }
+  else
+    {
+      // Offset is moved to zip64 extra field. It follows sizes, so it can be
+      // appended to existing field.
+      size_t extra_len = static_cast<size_t>(get16(record, 30));
+      size_t pos = 46 + static_cast<size_t>(get16(record, 28));
+      size_t end = pos + extra_len;
+      std::string val(8, 0);
+      set64(val, 0, offset);
+      bool found = false;
+      while(pos + 4 <= end)
+        {
+          size_t sz = static_cast<size_t>(get16(record, pos + 2));
+          if(get16(record, pos) == 1)
+            {
+              record.insert(pos + 4 + sz, val);
+              set16(record, pos + 2, static_cast<uint16_t>(sz + 8));
+              found = true;
+              break;
+            }
+          pos += 4 + sz;
+        }
+      if(!found)
+        {
+          std::string field(4, 0);
+          set16(field, 0, 1);
+          set16(field, 2, 8);
+          record.insert(end, field + val);
+          extra_len += 4;
+        }
+      set16(record, 30, static_cast<uint16_t>(extra_len + 8));
+      set32(record, 42, 0xffffffff);
+      if(get16(record, 6) < 45)
+        {
+          set16(record, 6, 45);
+        }
+    }
+
+  if(!fd->f)
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::appendEntry: output stream is closed");
+    }
+  fd->f->write(zip.c_str(), cd_offset);
+  if(!fd->f->good())
+    {
+      throw std::runtime_error(
+          "LibArchiveZipWriter::appendEntry: error while writing archive");
+    }
+  offset += static_cast<uint64_t>(cd_offset);
+  central_directory += record;
+  entries++;
+}
+
+la_ssize_t
+LibArchiveZipWriter::writeCallback(archive *, void *client_data,
+                                   const void *buffer, size_t length)
+{
+  std::string *result = reinterpret_cast<std::string *>(client_data);
+  result->append(reinterpret_cast<const char *>(buffer), length);
+
+  return static_cast<la_ssize_t>(length);
+}
@@ -19,9 +19,11 @@
 #include <archive.h>
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <omp.h>
 #include <random>
+#include <string_view>
 #include <unicode/unistr.h>
 
 MLBookProc::MLBookProc()
@@ -200,29 +202,176 @@ MLBookProc::getSupportedArchivesTypesPacking()
   return result;
 }
 
-bool
-MLBookProc::ifSupportedFile(const std::string &filename)
+MLBookProc::FileFormat
+MLBookProc::fileFormat(const std::string &file_name)
 {
-  bool result = false;
+  std::string::size_type n = file_name.find_last_of("/\\");
+  if(n == std::string::npos)
+    {
+      n = 0;
+    }
+  // Extensions of all supported formats consist of ASCII symbols, so there is
+  // no need in full Unicode case conversion here. Name is converted before
+  // extension extraction, so compound extensions like ".TAR.GZ" are found.
+  std::string name = file_name.substr(n);
+  for(auto it = name.begin(); it != name.end(); it++)
+    {
+      if(*it >= 'A' && *it <= 'Z')
+        {
+          *it = *it + ('a' - 'A');
+        }
+    }
+  std::string ext = getExtension(name);
+  if(ext.size() < 2)
+    {
+      return FileFormat::Unknown;
+    }
+  ext.erase(0, 1);
 
-  std::string lower = stringToLower(filename);
+  if(ext == "fb2")
+    {
+      return FileFormat::FB2;
+    }
+  else if(ext == "fbd")
+    {
+      return FileFormat::FBD;
+    }
+  else if(ext == "epub")
+    {
+      return FileFormat::EPUB;
+    }
+  else if(ext == "pdf")
+    {
+      return FileFormat::PDF;
+    }
+  else if(ext == "djvu")
+    {
+      return FileFormat::DJVU;
+    }
+  else if(ext == "odt")
+    {
+      return FileFormat::ODT;
+    }
+  else if(ext == "txt")
+    {
+      return FileFormat::TXT;
+    }
+  else if(ext == "md")
+    {
+      return FileFormat::MD;
+    }
+  else if(ext == "zip")
+    {
+      return FileFormat::ZIP;
+    }
 
-  lower = getExtension(lower);
+  auto it = std::find(supported_types.begin(), supported_types.end(), ext);
+  if(it != supported_types.end())
+    {
+      return FileFormat::Archive;
+    }
 
-  std::string find_str(".");
-  std::string::size_type n = lower.find(find_str);
-  if(n != std::string::npos)
+  return FileFormat::Unknown;
+}
+
+MLBookProc::FileFormat
+MLBookProc::fileFormat(const std::filesystem::path &p)
+{
+  std::u8string u8str = p.filename().u8string();
+  return fileFormat(std::string(u8str.begin(), u8str.end()));
+}
+
+MLBookProc::FileFormat
+MLBookProc::contentFormat(const std::string &buf)
+{
+  std::string_view view(buf);
+
+  if(view.starts_with(std::string_view("PK\x03\x04", 4)))
+    {
+      // EPUB and ODT containers start with uncompressed "mimetype" entry.
+      if(view.size() > 30)
+        {
+          size_t name_sz = static_cast<uint8_t>(view[26])
+                           | static_cast<uint8_t>(view[27]) << 8;
+          size_t extra_sz = static_cast<uint8_t>(view[28])
+                            | static_cast<uint8_t>(view[29]) << 8;
+          if(view.substr(30, name_sz) == "mimetype")
+            {
+              std::string_view mime
+                  = view.substr(std::min(30 + name_sz + extra_sz, view.size()));
+              if(mime.starts_with("application/epub+zip"))
+                {
+                  return FileFormat::EPUB;
+                }
+              else if(mime.starts_with(
+                          "application/vnd.oasis.opendocument.text"))
+                {
+                  return FileFormat::ODT;
+                }
+            }
+        }
+      return FileFormat::ZIP;
+    }
+
+  // PDF header may be preceded by some garbage.
+  if(view.substr(0, 1024).find("%PDF-") != std::string_view::npos)
     {
-      lower.erase(n, find_str.size());
+      return FileFormat::PDF;
     }
 
-  auto it = std::find(supported_types.begin(), supported_types.end(), lower);
-  if(it != supported_types.end())
+  if(view.starts_with("AT&TFORM"))
     {
-      result = true;
+      return FileFormat::DJVU;
     }
 
-  return result;
+  if(view.starts_with("\x1F\x8B") || view.starts_with("BZh")
+     || view.starts_with(std::string_view("\xFD" "7zXZ\x00", 6))
+     || view.starts_with("7z\xBC\xAF\x27\x1C")
+     || view.starts_with("Rar!\x1A\x07") || view.starts_with("070701")
+     || view.starts_with("070702") || view.starts_with("070707")
+     || (view.size() > 262 && view.substr(257, 5) == "ustar"))
+    {
+      return FileFormat::Archive;
+    }
+
+  if(view.starts_with("\xEF\xBB\xBF"))
+    {
+      view.remove_prefix(3);
+    }
+  std::string_view::size_type n = view.find_first_not_of(" \t\r\n");
+  if(n != std::string_view::npos && view[n] == '<'
+     && view.find("<FictionBook", n) != std::string_view::npos)
+    {
+      return FileFormat::FB2;
+    }
+
+  return FileFormat::Unknown;
+}
+
+MLBookProc::FileFormat
+MLBookProc::fileContentFormat(const std::filesystem::path &p)
+{
+  std::fstream f;
+  f.open(p, std::ios_base::in | std::ios_base::binary);
+  if(!f.is_open())
+    {
+      return FileFormat::Unknown;
+    }
+  std::string buf;
+  buf.resize(4096);
+  f.read(buf.data(), buf.size());
+  buf.resize(static_cast<size_t>(f.gcount()));
+  f.close();
+
+  return contentFormat(buf);
+}
+
+bool
+MLBookProc::ifSupportedFile(const std::string &filename)
+{
+  FileFormat format = fileFormat(filename);
+
+  return format != FileFormat::Unknown && format != FileFormat::FBD;
 }
 
 bool
@@ -336,23 +485,45 @@ MLBookProc::timeToDate(const time_t &tt)
 std::shared_ptr<DJVUContext>
 MLBookProc::getDJVUContext()
 {
-  std::lock_guard<std::mutex> lglock(djvu_context_mtx);
-  std::shared_ptr<DJVUContext> result = djvu_contex.lock();
-  if(!result.operator bool())
+  std::unique_ptr<DJVUContext> ctx;
+  djvu_context_mtx.lock();
+  if(!djvu_contexts.empty())
+    {
+      ctx = std::move(djvu_contexts.back());
+      djvu_contexts.pop_back();
+    }
+  djvu_context_mtx.unlock();
+  if(!ctx)
     {
-      result = std::make_shared<DJVUContext>();
-      ddjvu_message_set_callback(result->context,
-                                 &MLBookProc::djvuMessageCallback, this);
-      djvu_contex = result;
+      ctx = std::unique_ptr<DJVUContext>(new DJVUContext);
     }
 
-  return result;
+  return std::shared_ptr<DJVUContext>(ctx.release(),
+                                      [this](DJVUContext *ctx)
+                                        {
+                                          releaseDJVUContext(ctx);
+                                        });
+}
+
+std::shared_ptr<LibArchiveCache>
+MLBookProc::getArchiveCache()
+{
+  std::lock_guard<std::mutex> lglock(archive_cache_mtx);
+  if(!archive_cache)
+    {
+      archive_cache = std::make_shared<LibArchiveCache>();
+    }
+
+  return archive_cache;
 }
 
 void
-MLBookProc::djvuMessageCallback(ddjvu_context_t *context, void *closure)
+MLBookProc::releaseDJVUContext(DJVUContext *ctx)
 {
-  MLBookProc *mlbp = reinterpret_cast<MLBookProc *>(closure);
-  std::shared_ptr<DJVUContext> ctx = mlbp->getDJVUContext();
-  ctx->context_var.notify_all();
+  while(ddjvu_message_peek(ctx->context) != nullptr)
+    {
+      ddjvu_message_pop(ctx->context);
+    }
+  std::lock_guard<std::mutex> lglock(djvu_context_mtx);
+  djvu_contexts.emplace_back(ctx);
 }
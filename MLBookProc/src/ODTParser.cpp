@@ -40,13 +40,14 @@ ODTParser::parseBook(const std::string &book_content)
   UDBElement result;
   bid.setId(result, BaseID::Book);
 
-  std::vector<std::tuple<std::string, uint64_t, uint64_t>> files;
-  la->listFilesInZipBuffer(book_content, files);
+  LibArchiveZipReader zip(la, book_content);
+  const std::vector<std::tuple<std::string, uint64_t, uint64_t>> &files
+      = zip.files();
 
   std::filesystem::path sp = std::filesystem::path(u8"meta.xml");
   auto it = std::find_if(
       files.begin(), files.end(),
-      [sp](std::tuple<std::string, uint64_t, uint64_t> &el)
+      [sp](const std::tuple<std::string, uint64_t, uint64_t> &el)
         {
           std::filesystem::path fp = std::filesystem::path(
               std::u8string(std::get<0>(el).begin(), std::get<0>(el).end()));
@@ -54,26 +55,18 @@ ODTParser::parseBook(const std::string &book_content)
         });
   if(it != files.end())
     {
-      std::string meta_content
-          = la->unpackZipBufferFileToBuffer(book_content, std::get<0>(*it));
+      std::string meta_content = zip.unpack(std::get<0>(*it));
       std::vector<XMLElement> elements
           = xml_parser->parseDocument(meta_content);
 
-      std::vector<UDBElement> res = dc_parser->dcTitle(elements);
-      std::copy(res.begin(), res.end(),
-                std::back_inserter(result.subelements));
-
-      res = dc_parser->dcAuthor(elements);
-      std::copy(res.begin(), res.end(),
-                std::back_inserter(result.subelements));
-
-      res = dc_parser->dcGenre(elements);
-      std::copy(res.begin(), res.end(),
-                std::back_inserter(result.subelements));
-
-      res = dc_parser->dcDate(elements);
-      std::copy(res.begin(), res.end(),
-                std::back_inserter(result.subelements));
+      DublinCoreMetadata metadata = dc_parser->dcParse(elements);
+      for(std::vector<UDBElement> *res :
+          {&metadata.title, &metadata.author, &metadata.genre,
+           &metadata.date})
+        {
+          std::move(res->begin(), res->end(),
+                    std::back_inserter(result.subelements));
+        }
     }
 
   return result;
@@ -84,45 +77,34 @@ ODTParser::getBookInfo(const std::string &book_content)
 {
   UDBase result;
 
-  std::vector<std::tuple<std::string, uint64_t, uint64_t>> filenames;
-  la->listFilesInZipBuffer(book_content, filenames);
+  LibArchiveZipReader zip(la, book_content);
 
-  auto it
-      = std::find_if(filenames.begin(), filenames.end(),
-                     [](const std::tuple<std::string, uint64_t, uint64_t> &el)
-                       {
-                         return std::get<0>(el) == "meta.xml";
-                       });
-  if(it != filenames.end())
+  if(zip.contains("meta.xml"))
     {
-      std::string buf = la->unpackBufferFileToBuffer(
-          book_content, std::get<0>(*it), std::get<2>(*it));
+      std::string buf = zip.unpack("meta.xml");
       if(buf.size() > 0)
         {
           std::vector<XMLElement> elements = xml_parser->parseDocument(buf);
+          DublinCoreMetadata metadata = dc_parser->dcParse(elements);
+
           UDBElement el;
           bid.setId(el, BaseID::Annotation);
-          el.content = dc_parser->dcDescription(elements);
+          el.content = std::move(metadata.description);
           normalizeString(el.content);
           if(!el.content.empty())
             {
               result.addElement(el);
             }
 
-          std::vector<UDBElement> res = dc_parser->dcLanguage(elements);
-          result.addElements(res);
+          result.addElements(metadata.language);
 
-          res = dc_parser->dcTranslator(elements);
-          result.addElements(res);
+          result.addElements(metadata.translator);
 
-          res = dc_parser->dcPublisher(elements);
-          result.addElements(res);
+          result.addElements(metadata.publisher);
 
-          res = dc_parser->dcIdentifier(elements);
-          result.addElements(res);
+          result.addElements(metadata.identifier);
 
-          res = dc_parser->dcSource(elements);
-          result.addElements(res);
+          result.addElements(metadata.source);
 
           std::vector<XMLElement *> meta;
           XMLAlgorithms::searchElement(elements, "meta:generator", meta);
@@ -147,17 +129,11 @@ ODTParser::getBookInfo(const std::string &book_content)
         }
     }
 
-  it = std::find_if(filenames.begin(), filenames.end(),
-                    [](const std::tuple<std::string, uint64_t, uint64_t> &el)
-                      {
-                        return std::get<0>(el) == "Thumbnails/thumbnail.png";
-                      });
-  if(it != filenames.end())
+  if(zip.contains("Thumbnails/thumbnail.png"))
     {
       UDBElement el;
       bid.setId(el, BaseID::CoverPage);
-      el.content = la->unpackBufferFileToBuffer(book_content, std::get<0>(*it),
-                                                std::get<2>(*it));
+      el.content = zip.unpack("Thumbnails/thumbnail.png");
       if(!el.content.empty())
         {
           UDBElement type;
@@ -21,7 +21,6 @@ OpenBook::OpenBook(const std::shared_ptr<MLBookProc> &mlbp)
 {
   this->mlbp = mlbp;
   la = new LibArchive(mlbp);
-  supported_archives = mlbp->getSupportedArchivesTypesUnpacking();
 }
 
 OpenBook::~OpenBook()
@@ -89,18 +88,8 @@ OpenBook::openBook(
     const UDBElement &path)
 {
   call_count++;
-  std::string ext = mlbp->getExtension(p);
-  ext = mlbp->stringToLower(ext);
-  std::string find_str(".");
-  std::string::size_type n = ext.find(find_str);
-  if(n != std::string::npos)
-    {
-      ext.erase(0, n + find_str.size());
-    }
-
-  auto it
-      = std::find(supported_archives.begin(), supported_archives.end(), ext);
-  if(it == supported_archives.end())
+  MLBookProc::FileFormat format = mlbp->fileFormat(p);
+  if(format != MLBookProc::ZIP && format != MLBookProc::Archive)
     {
       if(call_count == 1)
         {
@@ -129,7 +118,7 @@ OpenBook::openBook(
       if(bid.getId(path) == BaseID::PathInFile)
         {
           std::filesystem::path res;
-          if(ext == "zip")
+          if(format == MLBookProc::ZIP)
             {
               res = la->unpackZipFileToDirectory(p, path.content, *tmp_p);
             }
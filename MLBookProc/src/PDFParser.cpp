@@ -16,6 +16,7 @@
 
 #include <PDFParser.h>
 #include <algorithm>
+#include <fstream>
 #include <poppler-document.h>
 #include <poppler-page-renderer.h>
 #include <poppler-page.h>
@@ -29,9 +30,6 @@ PDFParser::PDFParser(const std::shared_ptr<MLBookProc> &mlbp)
 UDBElement
 PDFParser::parseBook(const std::string &book_content)
 {
-  UDBElement result;
-  bid.setId(result, BaseID::Book);
-
   std::unique_ptr<poppler::document> doc(poppler::document::load_from_raw_data(
       book_content.c_str(), static_cast<int>(book_content.size())));
   if(doc.get() == nullptr)
@@ -39,6 +37,101 @@ PDFParser::parseBook(const std::string &book_content)
       throw std::runtime_error("PDFParser::parseBook: document is null");
     }
 
+  return parseDocument(doc.get());
+}
+
+UDBElement
+PDFParser::parseBook(const std::filesystem::path &file_path)
+{
+  std::unique_ptr<poppler::document> doc = loadFile(file_path);
+  if(doc.get() == nullptr)
+    {
+      throw std::runtime_error("PDFParser::parseBook: document is null");
+    }
+
+  return parseDocument(doc.get());
+}
+
+UDBase
+PDFParser::getBookInfo(const std::string &book_content)
+{
+  std::unique_ptr<poppler::document> doc(poppler::document::load_from_raw_data(
+      book_content.c_str(), static_cast<int>(book_content.size())));
+  if(doc.get() == nullptr)
+    {
+      throw std::runtime_error("PDFParser::getBookInfo: document is null");
+    }
+
+  return documentInfo(doc.get());
+}
+
+UDBase
+PDFParser::getBookInfo(const std::filesystem::path &file_path)
+{
+  std::unique_ptr<poppler::document> doc = loadFile(file_path);
+  if(doc.get() == nullptr)
+    {
+      throw std::runtime_error("PDFParser::getBookInfo: document is null");
+    }
+
+  return documentInfo(doc.get());
+}
+
+std::unique_ptr<poppler::document>
+PDFParser::loadFile(const std::filesystem::path &file_path)
+{
+  std::unique_ptr<poppler::document> doc;
+#ifdef _WIN32
+  // poppler opens files by narrow names only, so on Windows paths containing
+  // non-ASCII symbols are read into memory.
+  std::wstring wstr = file_path.native();
+  if(std::find_if(wstr.begin(), wstr.end(),
+                  [](const wchar_t &ch)
+                    {
+                      return ch > 127;
+                    })
+     == wstr.end())
+    {
+      doc = std::unique_ptr<poppler::document>(
+          poppler::document::load_from_file(file_path.string()));
+      return doc;
+    }
+
+  std::fstream f;
+  f.open(file_path, std::ios_base::in | std::ios_base::binary);
+  if(!f.is_open())
+    {
+      throw std::runtime_error("PDFParser::loadFile: cannot open file");
+    }
+  f.seekg(0, std::ios_base::end);
+  std::fpos pos = f.tellg();
+  if(pos <= 0)
+    {
+      throw std::runtime_error("PDFParser::loadFile: incorrect file size");
+    }
+  // load_from_data() takes buffer ownership: poppler reads from it during
+  // whole document life time.
+  poppler::byte_array buf;
+  buf.resize(static_cast<size_t>(pos));
+  f.seekg(0, std::ios_base::beg);
+  f.read(buf.data(), buf.size());
+  f.close();
+  doc = std::unique_ptr<poppler::document>(
+      poppler::document::load_from_data(&buf));
+#else
+  doc = std::unique_ptr<poppler::document>(
+      poppler::document::load_from_file(file_path.string()));
+#endif
+
+  return doc;
+}
+
+UDBElement
+PDFParser::parseDocument(poppler::document *doc)
+{
+  UDBElement result;
+  bid.setId(result, BaseID::Book);
+
   std::vector<char> buf = doc->get_author().to_utf8();
   if(buf.size() > 0)
     {
@@ -85,15 +178,9 @@ PDFParser::parseBook(const std::string &book_content)
 }
 
 UDBase
-PDFParser::getBookInfo(const std::string &book_content)
+PDFParser::documentInfo(poppler::document *doc)
 {
   UDBase result;
-  std::unique_ptr<poppler::document> doc(poppler::document::load_from_raw_data(
-      book_content.c_str(), static_cast<int>(book_content.size())));
-  if(doc.get() == nullptr)
-    {
-      throw std::runtime_error("PDFParser::getBookInfo: document is null");
-    }
 
   std::vector<char> buf = doc->get_subject().to_utf8();
   UDBElement el;
@@ -105,16 +192,20 @@ PDFParser::getBookInfo(const std::string &book_content)
       result.addElement(el);
     }
 
-  if(doc->pages() > 0 && poppler::page_renderer::can_render())
+  if(render_cover && doc->pages() > 0
+     && poppler::page_renderer::can_render())
     {
       std::unique_ptr<poppler::page> page(doc->create_page(0));
       if(page.get() != nullptr)
         {
+          double h_dpi = horizontal_dpi;
+          double v_dpi = vertical_dpi;
+          coverDPI(page.get(), h_dpi, v_dpi);
           std::unique_ptr<poppler::page_renderer> renderer(
               new poppler::page_renderer);
           renderer->set_image_format(poppler::image::format_argb32);
-          poppler::image image = renderer->render_page(
-              page.get(), horizontal_dpi, vertical_dpi);
+          poppler::image image
+              = renderer->render_page(page.get(), h_dpi, v_dpi);
           char *data = image.data();
           int lim = image.bytes_per_row() * image.height();
           UDBElement el;
@@ -189,6 +280,19 @@ PDFParser::setDPI(const double &horizontal_dpi, const double &vertical_dpi)
   this->vertical_dpi = vertical_dpi;
 }
 
+void
+PDFParser::setCoverSize(const int &max_width, const int &max_height)
+{
+  max_cover_width = max_width;
+  max_cover_height = max_height;
+}
+
+void
+PDFParser::setCoverRendering(const bool &render)
+{
+  render_cover = render;
+}
+
 double
 PDFParser::getHorizontalDPI()
 {
@@ -201,6 +305,39 @@ PDFParser::getVerticalDPI()
   return vertical_dpi;
 }
 
+void
+PDFParser::coverDPI(poppler::page *page, double &h_dpi, double &v_dpi)
+{
+  if(max_cover_width <= 0 && max_cover_height <= 0)
+    {
+      return void();
+    }
+
+  // Page size is given in points (1/72 inch) without page rotation.
+  poppler::rectf rect = page->page_rect();
+  double w = rect.width();
+  double h = rect.height();
+  poppler::page::orientation_enum orient = page->orientation();
+  if(orient == poppler::page::landscape || orient == poppler::page::seascape)
+    {
+      std::swap(w, h);
+    }
+  w *= h_dpi / 72.0;
+  h *= v_dpi / 72.0;
+
+  double scale = 1.0;
+  if(max_cover_width > 0 && w > static_cast<double>(max_cover_width))
+    {
+      scale = static_cast<double>(max_cover_width) / w;
+    }
+  if(max_cover_height > 0 && h * scale > static_cast<double>(max_cover_height))
+    {
+      scale = static_cast<double>(max_cover_height) / h;
+    }
+  h_dpi *= scale;
+  v_dpi *= scale;
+}
+
 void
 PDFParser::normalizeString(std::string &str)
 {
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <ParserPool.h>
+
+ParserPool::ParserPool(const std::shared_ptr<MLBookProc> &mlbp)
+{
+  this->mlbp = mlbp;
+}
+
+ParserPool::~ParserPool()
+{
+  std::lock_guard<std::mutex> lglock(pool_mtx);
+}
+
+template <typename T>
+std::shared_ptr<T>
+ParserPool::lease(std::vector<std::unique_ptr<T>> &pool)
+{
+  std::unique_ptr<T> parser;
+  pool_mtx.lock();
+  if(!pool.empty())
+    {
+      parser = std::move(pool.back());
+      pool.pop_back();
+    }
+  pool_mtx.unlock();
+  if(!parser)
+    {
+      parser = std::unique_ptr<T>(new T(mlbp));
+    }
+
+  return std::shared_ptr<T>(parser.release(),
+                            [this, &pool](T *parser)
+                              {
+                                std::lock_guard<std::mutex> lglock(pool_mtx);
+                                pool.emplace_back(parser);
+                              });
+}
+
+std::shared_ptr<FB2Parser>
+ParserPool::getFB2Parser()
+{
+  return lease(fb2_parsers);
+}
+
+std::shared_ptr<EPUBParser>
+ParserPool::getEPUBParser()
+{
+  return lease(epub_parsers);
+}
+
+std::shared_ptr<ODTParser>
+ParserPool::getODTParser()
+{
+  return lease(odt_parsers);
+}
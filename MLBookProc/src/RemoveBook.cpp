@@ -25,53 +25,83 @@
 RemoveBook::RemoveBook(const std::shared_ptr<MLBookProc> &mlbp)
     : LibArchive(mlbp)
 {
+  setCompressionThreads(std::thread::hardware_concurrency());
 }
 
 void
 RemoveBook::removeBook(const std::filesystem::path &base_path,
                        const UDBElement &book_search_result)
 {
-  auto it_fl = std::find_if(book_search_result.subelements.begin(),
-                            book_search_result.subelements.end(),
-                            [this](const UDBElement &el)
-                              {
-                                return bid.getId(el) == BaseID::File;
-                              });
-  if(it_fl == book_search_result.subelements.end())
-    {
-      throw std::runtime_error(
-          "RemoveBook::removeBook: cannot find file path");
-    }
-
-  std::filesystem::path book_fl
-      = std::u8string(it_fl->content.begin(), it_fl->content.end());
-
-  auto it_book = std::find_if(book_search_result.subelements.begin(),
-                              book_search_result.subelements.end(),
-                              [this](const UDBElement &el)
-                                {
-                                  return bid.getId(el) == BaseID::Book;
-                                });
-
-  if(it_book == book_search_result.subelements.end())
-    {
-      throw std::runtime_error("RemoveBook::removeBook: not a book entry");
-    }
+  std::vector<UDBElement> book_search_results;
+  book_search_results.push_back(book_search_result);
+  removeBooks(base_path, book_search_results);
+}
 
-  std::string ext = mlbp->getExtension(it_fl->content);
-  ext = mlbp->stringToLower(ext);
+void
+RemoveBook::removeBooks(const std::filesystem::path &base_path,
+                        const std::vector<UDBElement> &book_search_results)
+{
   std::shared_ptr<RefreshCollection> refr(
       new RefreshCollection(mlbp, std::thread::hardware_concurrency()));
   refr->signal_parsing_progress = signal_parsing_progress;
-  if(ext == ".rar")
-    {
-      std::filesystem::remove_all(book_fl);
-      refr->refreshCollection(base_path);
-    }
-  else
+
+  removeBookFiles(book_search_results);
+
+  refr->refreshCollection(base_path);
+}
+
+void
+RemoveBook::setKeepHoles(const bool &keep_holes)
+{
+  this->keep_holes = keep_holes;
+}
+
+void
+RemoveBook::removeBookFiles(const std::vector<UDBElement> &book_search_results)
+{
+  std::vector<std::string> arch_type
+      = mlbp->getSupportedArchivesTypesPacking();
+
+  // zip archive path, paths of books in archive
+  std::vector<std::tuple<std::filesystem::path, std::vector<UDBElement>>> zip;
+  for(auto it_bsr = book_search_results.begin();
+      it_bsr != book_search_results.end(); it_bsr++)
     {
-      std::vector<std::string> arch_type
-          = mlbp->getSupportedArchivesTypesPacking();
+      auto it_fl = std::find_if(it_bsr->subelements.begin(),
+                                it_bsr->subelements.end(),
+                                [this](const UDBElement &el)
+                                  {
+                                    return bid.getId(el) == BaseID::File;
+                                  });
+      if(it_fl == it_bsr->subelements.end())
+        {
+          throw std::runtime_error(
+              "RemoveBook::removeBookFiles: cannot find file path");
+        }
+
+      std::filesystem::path book_fl
+          = std::u8string(it_fl->content.begin(), it_fl->content.end());
+
+      auto it_book = std::find_if(it_bsr->subelements.begin(),
+                                  it_bsr->subelements.end(),
+                                  [this](const UDBElement &el)
+                                    {
+                                      return bid.getId(el) == BaseID::Book;
+                                    });
+
+      if(it_book == it_bsr->subelements.end())
+        {
+          throw std::runtime_error(
+              "RemoveBook::removeBookFiles: not a book entry");
+        }
+
+      std::string ext = mlbp->getExtension(it_fl->content);
+      ext = mlbp->stringToLower(ext);
+      if(ext == ".rar")
+        {
+          std::filesystem::remove_all(book_fl);
+          continue;
+        }
 
       std::string find_str(".");
       std::string::size_type n = ext.find(find_str);
@@ -84,27 +114,96 @@ RemoveBook::removeBook(const std::filesystem::path &base_path,
       if(it_sup == arch_type.end())
         {
           std::filesystem::remove_all(book_fl);
-          refr->refreshCollection(base_path);
+          continue;
         }
-      else
+
+      auto it_path
+          = std::find_if(it_book->subelements.begin(),
+                         it_book->subelements.end(),
+                         [this](const UDBElement &el)
+                           {
+                             return bid.getId(el) == BaseID::PathInFile;
+                           });
+      if(it_path == it_book->subelements.end())
         {
-          auto it_path = std::find_if(
-              it_book->subelements.begin(), it_book->subelements.end(),
+          throw std::runtime_error(
+              "RemoveBook::removeBookFiles: cannot find path in archive");
+        }
+
+      if(ext == "zip")
+        {
+          auto it_nested = std::find_if(
+              it_path->subelements.begin(), it_path->subelements.end(),
               [this](const UDBElement &el)
                 {
                   return bid.getId(el) == BaseID::PathInFile;
                 });
-          if(it_path == it_book->subelements.end())
+          if(it_nested == it_path->subelements.end())
+            {
+              auto it_zip = std::find_if(
+                  zip.begin(), zip.end(),
+                  [book_fl](const std::tuple<std::filesystem::path,
+                                             std::vector<UDBElement>> &el)
+                    {
+                      return std::get<0>(el) == book_fl;
+                    });
+              if(it_zip == zip.end())
+                {
+                  zip.emplace_back(
+                      std::make_tuple(book_fl, std::vector<UDBElement>()));
+                  it_zip = zip.end() - 1;
+                }
+              std::get<1>(*it_zip).push_back(*it_path);
+              continue;
+            }
+        }
+
+      size_t count = removeFromArchive(*it_path, book_fl);
+      if(count == 0)
+        {
+          std::filesystem::remove_all(book_fl);
+        }
+    }
+
+  for(auto it = zip.begin(); it != zip.end(); it++)
+    {
+      std::vector<std::string> filenames;
+      for(auto it_p = std::get<1>(*it).begin(); it_p != std::get<1>(*it).end();
+          it_p++)
+        {
+          filenames.push_back(it_p->content);
+          auto it_fbd
+              = std::find_if(it_p->subelements.begin(),
+                             it_p->subelements.end(),
+                             [this](const UDBElement &el)
+                               {
+                                 return bid.getId(el) == BaseID::FBDPath;
+                               });
+          if(it_fbd != it_p->subelements.end())
             {
-              throw std::runtime_error(
-                  "RemoveBook::removeBook: cannot find path in archive");
+              filenames.push_back(it_fbd->content);
             }
-          size_t count = removeFromArchive(*it_path, book_fl);
-          if(count == 0)
+        }
+
+      size_t count;
+      try
+        {
+          count = removeFromZip(std::get<0>(*it), filenames, keep_holes);
+        }
+      catch(std::invalid_argument &er)
+        {
+          // Archive has not been modified, so it can be repacked.
+          std::cout << er.what() << std::endl;
+          count = 1;
+          for(auto it_p = std::get<1>(*it).begin();
+              it_p != std::get<1>(*it).end() && count > 0; it_p++)
             {
-              std::filesystem::remove_all(book_fl);
+              count = removeFromArchive(*it_p, std::get<0>(*it));
             }
-          refr->refreshCollection(base_path);
+        }
+      if(count == 0)
+        {
+          std::filesystem::remove_all(std::get<0>(*it));
         }
     }
 }
@@ -179,12 +278,21 @@ RemoveBook::removeFromArchive(const UDBElement &path,
         }
     }
 
-  er = archive_write_open(
-      a_write.get(), fd_write.get(), &LibArchive::openCallBack,
-      &LibArchive::writeCallback, &LibArchive::closeCallback);
-  if(er != ARCHIVE_OK)
+  std::shared_ptr<LibArchiveZipWriter> zip_writer
+      = setWriteThreads(a_write, fd_write);
+  if(a_write)
     {
-      archiveError(a_write, "RemoveBook::removeFromArchive:");
+      er = archive_write_open(
+          a_write.get(), fd_write.get(), &LibArchive::openCallBack,
+          &LibArchive::writeCallback, &LibArchive::closeCallback);
+      if(er != ARCHIVE_OK)
+        {
+          archiveError(a_write, "RemoveBook::removeFromArchive:");
+        }
+    }
+  else
+    {
+      er = ARCHIVE_OK;
     }
 
   int retry_count = 0;
@@ -265,7 +373,7 @@ RemoveBook::removeFromArchive(const UDBElement &path,
                                 std::filesystem::perms perms
                                     = getPermissionsFromEntry(e);
                                 writeFile(a_write, random, path.content,
-                                          perms);
+                                          perms, zip_writer);
                                 result++;
                               }
                           }
@@ -275,7 +383,7 @@ RemoveBook::removeFromArchive(const UDBElement &path,
                   {
                     std::string buf = unpackEntryToBuffer(a_read, e);
                     setUsernameGroupname(e);
-                    writeBufferToArchive(a_write, e, buf);
+                    writeEntry(a_write, zip_writer, e, buf);
                     result++;
                   }
               }
@@ -299,8 +407,14 @@ RemoveBook::removeFromArchive(const UDBElement &path,
       archive_entry_clear(e.get());
     }
 
+  if(zip_writer)
+    {
+      zip_writer->finish();
+    }
   a_read.reset();
   a_write.reset();
+  zip_writer.reset();
+  fd_write->f.reset();
   if(result > 0)
     {
       std::filesystem::remove_all(fd_read->path);
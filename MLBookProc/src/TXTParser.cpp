@@ -16,6 +16,7 @@
 
 #include <TXTParser.h>
 #include <XMLTextEncoding.h>
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 
@@ -74,53 +75,174 @@ TXTParser::getBookInfo(const std::filesystem::path &file_path)
       result.addElement(el);
     }
 
+  std::string buf = readPrefix(file_path);
+  coverPage(result, buf, mlbp->fileFormat(file_path));
+
+  return result;
+}
+
+UDBase
+TXTParser::getBookInfo(const std::string &book_content,
+                       const MLBookProc::FileFormat &format)
+{
+  UDBase result;
+
   std::string buf;
-  std::fstream f;
-  f.open(file_path, std::ios_base::in | std::ios_base::binary);
-  if(f.is_open())
+  if(book_content.size() > preview_limit)
     {
-      f.seekg(0, std::ios_base::end);
-      buf.resize(f.tellg());
-      f.seekg(0, std::ios_base::beg);
-      f.read(buf.data(), buf.size());
-      f.close();
+      buf = book_content.substr(0, preview_limit);
+      trimPrefix(buf);
     }
   else
     {
-      return result;
+      buf = book_content;
     }
+  coverPage(result, buf, format);
 
-  if(buf.size() > 0)
+  return result;
+}
+
+void
+TXTParser::setPreviewLimit(const size_t &preview_limit)
+{
+  this->preview_limit = preview_limit;
+}
+
+void
+TXTParser::coverPage(UDBase &result, const std::string &prefix,
+                     const MLBookProc::FileFormat &format)
+{
+  if(prefix.empty())
     {
-      std::vector<std::string> enc
-          = XMLTextEncoding::detectStringEncoding(buf);
-      el = UDBElement();
-      bid.setId(el, BaseID::CoverPage);
-      if(enc.size() > 0)
+      return void();
+    }
+
+  std::string enc = textEncoding(prefix);
+  UDBElement el;
+  bid.setId(el, BaseID::CoverPage);
+  if(!enc.empty())
+    {
+      XMLTextEncoding::convertToEncoding(prefix, el.content, enc, "UTF-8");
+    }
+  else
+    {
+      el.content = prefix;
+    }
+  if(!el.content.empty())
+    {
+      UDBElement type;
+      bid.setId(type, BaseID::CoverType);
+      if(format == MLBookProc::MD)
         {
-          XMLTextEncoding::convertToEncoding(buf, el.content, enc[0], "UTF-8");
+          type.content = "md";
         }
       else
         {
-          el.content = buf;
+          type.content = "txt";
+        }
+      el.subelements.emplace_back(type);
+      result.addElement(el);
+    }
+}
+
+std::string
+TXTParser::readPrefix(const std::filesystem::path &file_path)
+{
+  std::string result;
+
+  std::fstream f;
+  f.open(file_path, std::ios_base::in | std::ios_base::binary);
+  if(!f.is_open())
+    {
+      return result;
+    }
+  f.seekg(0, std::ios_base::end);
+  size_t fsz = static_cast<size_t>(f.tellg());
+  f.seekg(0, std::ios_base::beg);
+  result.resize(std::min(fsz, preview_limit));
+  f.read(result.data(), result.size());
+  result.resize(static_cast<size_t>(f.gcount()));
+  f.close();
+
+  if(result.size() < fsz)
+    {
+      trimPrefix(result);
+    }
+
+  return result;
+}
+
+void
+TXTParser::trimPrefix(std::string &prefix)
+{
+  // NUL bytes mean UTF-16 or UTF-32 text: keep whole code units only.
+  if(prefix.find('\0') != std::string::npos)
+    {
+      prefix.resize(prefix.size() - prefix.size() % 4);
+      return void();
+    }
+
+  // Line feed cannot be a part of multibyte sequence in any ASCII compatible
+  // encoding, so cutting after it never splits a character.
+  std::string::size_type n = prefix.rfind('\n');
+  if(n != std::string::npos)
+    {
+      prefix.resize(n + 1);
+      return void();
+    }
+
+  // No line breaks at all: drop incomplete UTF-8 sequence, if any.
+  size_t i = prefix.size();
+  size_t cont = 0;
+  while(i > 0 && cont < 3
+        && (static_cast<unsigned char>(prefix[i - 1]) & 0xC0) == 0x80)
+    {
+      i--;
+      cont++;
+    }
+  if(i > 0)
+    {
+      unsigned char lead = static_cast<unsigned char>(prefix[i - 1]);
+      size_t len = 1;
+      if((lead & 0xE0) == 0xC0)
+        {
+          len = 2;
         }
-      if(!el.content.empty())
+      else if((lead & 0xF0) == 0xE0)
         {
-          std::string ext = mlbp->getExtension(file_path);
-          ext = mlbp->stringToLower(ext);
-          UDBElement type;
-          bid.setId(type, BaseID::CoverType);
-          if(ext == ".txt")
-            {
-              type.content = "txt";
-            }
-          else
-            {
-              type.content = "md";
-            }
-          el.subelements.emplace_back(type);
-          result.addElement(el);
+          len = 3;
         }
+      else if((lead & 0xF8) == 0xF0)
+        {
+          len = 4;
+        }
+      if(len > cont + 1)
+        {
+          prefix.resize(i - 1);
+        }
+    }
+}
+
+std::string
+TXTParser::textEncoding(const std::string &prefix)
+{
+  std::string result = XMLTextEncoding::detectBOMEncoding(prefix);
+  if(!result.empty())
+    {
+      return result;
+    }
+
+  if(prefix.find('\0') == std::string::npos
+     && XMLTextEncoding::isValidUTF8(prefix))
+    {
+      return std::string("UTF-8");
+    }
+
+  std::vector<std::string> enc
+      = XMLTextEncoding::detectStringEncoding(prefix);
+  if(enc.size() > 0)
+    {
+      result = enc[0];
     }
 
   return result;
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef COVERCACHE_H
+#define COVERCACHE_H
+
+#include <BaseID.h>
+#include <QImage>
+#include <UDBElement.h>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class CoverCache
+{
+public:
+  CoverCache(const std::filesystem::path &cache_dir,
+             const uintmax_t &size_limit = uintmax_t(268435456));
+
+  std::string
+  coverKey(const UDBElement &book_search_result);
+
+  QImage
+  loadCover(const std::string &key);
+
+  void
+  saveCover(const std::string &key, const QImage &cover);
+
+private:
+  void
+  pathInFile(const UDBElement &path, std::string &result);
+
+  uintmax_t
+  scanCovers(
+      std::vector<std::tuple<std::filesystem::path,
+                             std::filesystem::file_time_type, uintmax_t>>
+          &covers);
+
+  void
+  removeOldCovers();
+
+  std::filesystem::path cache_dir;
+
+  uintmax_t size_limit;
+
+  uintmax_t cache_size = 0;
+
+  std::mutex cache_mtx;
+
+  BaseID bid;
+};
+
+#endif // COVERCACHE_H
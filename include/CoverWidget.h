@@ -22,6 +22,7 @@
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QResizeEvent>
+#include <QSizeF>
 #include <QWidget>
 #include <UDBElement.h>
 #include <memory>
@@ -38,9 +39,28 @@ public:
   void
   setCover(const UDBElement &cover_obj);
 
+  void
+  setCoverImage(const QImage &image);
+
+  QImage
+  coverImage(const UDBElement &cover_obj, const QSizeF &pixels_per_mm);
+
+  QSizeF
+  pixelsPerMM();
+
   void
   clearCover();
 
+  void
+  setFullCoverOnDemand(const bool &on_demand);
+
+  void
+  showCoverWindow(const QImage &image);
+
+signals:
+  void
+  signalFullCoverRequested();
+
 private:
   void
   paintEvent(QPaintEvent *event) override;
@@ -66,6 +86,8 @@ private:
 
   bool need_byte_conversion = false;
 
+  bool full_cover_on_demand = false;
+
   std::vector<QAction *> act_list;
 
   BaseID bid;
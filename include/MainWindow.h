@@ -17,6 +17,7 @@
 #define MAINWINDOW_H
 
 #include <Bases.h>
+#include <CoverCache.h>
 #include <PluginManager.h>
 #include <QCloseEvent>
 #include <QMainWindow>
@@ -66,6 +67,7 @@ private:
   std::shared_ptr<SettingsManager> settings;
 
   std::shared_ptr<PluginManager> plugins;
+  std::shared_ptr<CoverCache> cover_cache;
 
 signals:
   void
@@ -19,14 +19,17 @@
 #include <BaseID.h>
 #include <Bases.h>
 #include <BookInfo.h>
+#include <CoverCache.h>
 #include <CoverWidget.h>
 #include <FormatAnnotation.h>
 #include <OpenBook.h>
 #include <QComboBox>
+#include <QImage>
 #include <QLineEdit>
 #include <QMetaObject>
 #include <QPaintEvent>
 #include <QPushButton>
+#include <QSize>
 #include <QTableView>
 #include <QTextBrowser>
 #include <QToolButton>
@@ -37,13 +40,15 @@
 #include <UDBase.h>
 #include <condition_variable>
 #include <memory>
+#include <optional>
 
 class MainWindowRightWidget : public QWidget
 {
   Q_OBJECT
 public:
   MainWindowRightWidget(QWidget *parent, const Bases &bases,
-                        const std::shared_ptr<SettingsManager> &settings);
+                        const std::shared_ptr<SettingsManager> &settings,
+                        const std::shared_ptr<CoverCache> &cover_cache);
 
   virtual ~MainWindowRightWidget();
 
@@ -108,6 +113,21 @@ private:
   void
   getBookInfo(const QModelIndex &index);
 
+  void
+  clearBookInfo();
+
+  bool
+  currentBookInfo(const uint64_t &request_id);
+
+  void
+  bookInfoWorker();
+
+  void
+  showFullCover();
+
+  void
+  formatAnnotation(std::string &annotation);
+
   void
   formTagReplacementTable(
       std::vector<ReplaceTagItem> &replacement_table,
@@ -133,6 +153,7 @@ private:
 
   Bases bases;
   std::shared_ptr<SettingsManager> settings;
+  std::shared_ptr<CoverCache> cover_cache;
 
   TableView *search_view;
 
@@ -167,7 +188,7 @@ private:
   std::filesystem::path book_open_dir;
 
   QMetaObject::Connection search_result_doubleclicked;
-  QMetaObject::Connection search_result_singleclicked;
+  QMetaObject::Connection search_result_current_changed;
   QMetaObject::Connection search_result_resize;
 
   BaseID bid;
@@ -178,7 +199,28 @@ private:
   std::mutex thr_num_mtx;
   std::condition_variable thr_num_var;
 
+  struct BookInfoRequest
+  {
+    uint64_t id = 0;
+    UDBElement book_search_result;
+    double horizontal_dpi = 72.0;
+    double vertical_dpi = 72.0;
+    QSize cover_size;
+    QSizeF pixels_per_mm;
+  };
+
+  std::optional<BookInfoRequest> pending_info;
+  uint64_t info_request_id = 0;
+  bool info_worker_running = false;
+  std::mutex info_mtx;
+
 signals:
+  void
+  signalBookAnnotation(const uint64_t &request_id, const QString &text);
+
+  void
+  signalBookCover(const uint64_t &request_id, const QImage &image);
+
   void
   signalShowBooks(const UDBase &search_result, QWidget *spw,
                   const std::filesystem::path &collection_base_path);  
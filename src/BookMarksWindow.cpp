@@ -222,6 +222,8 @@ BookMarksWindow::createWindow()
               book_info->setDPI(
                   static_cast<double>(screen->physicalDotsPerInchX()),
                   static_cast<double>(screen->physicalDotsPerInchY()));
+              QSize av_sz = screen->availableSize();
+              book_info->setCoverSize(av_sz.width(), av_sz.height());
               try
                 {
                   UDBase info = book_info->getBookInfo(*bm);
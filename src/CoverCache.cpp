@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Yury Bobylev <bobilev_yury@mail.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <CoverCache.h>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+CoverCache::CoverCache(const std::filesystem::path &cache_dir,
+                       const uintmax_t &size_limit)
+{
+  this->cache_dir = cache_dir;
+  this->size_limit = size_limit;
+
+  std::vector<std::tuple<std::filesystem::path,
+                         std::filesystem::file_time_type, uintmax_t>>
+      covers;
+  cache_size = scanCovers(covers);
+}
+
+std::string
+CoverCache::coverKey(const UDBElement &book_search_result)
+{
+  std::string result;
+
+  std::vector<UDBElement>::const_iterator it
+      = std::find_if(book_search_result.subelements.begin(),
+                     book_search_result.subelements.end(),
+                     [this](const UDBElement &el)
+                       {
+                         return bid.getId(el) == BaseID::File;
+                       });
+  if(it == book_search_result.subelements.end())
+    {
+      return result;
+    }
+
+  std::filesystem::path p
+      = std::u8string(it->content.begin(), it->content.end());
+  std::error_code ec;
+  uintmax_t fsz = std::filesystem::file_size(p, ec);
+  if(ec)
+    {
+      return result;
+    }
+  std::filesystem::file_time_type lwt = std::filesystem::last_write_time(p, ec);
+  if(ec)
+    {
+      return result;
+    }
+
+  // Size and modification time are part of the key, so covers of changed
+  // files are never taken from cache. Old entries are removed by
+  // removeOldCovers() eventually.
+  std::string fingerprint = it->content;
+  fingerprint += "\n" + std::to_string(fsz);
+  fingerprint += "\n" + std::to_string(lwt.time_since_epoch().count());
+
+  it = std::find_if(book_search_result.subelements.begin(),
+                    book_search_result.subelements.end(),
+                    [this](const UDBElement &el)
+                      {
+                        return bid.getId(el) == BaseID::Book;
+                      });
+  if(it != book_search_result.subelements.end())
+    {
+      std::vector<UDBElement>::const_iterator it_p
+          = std::find_if(it->subelements.begin(), it->subelements.end(),
+                         [this](const UDBElement &el)
+                           {
+                             return bid.getId(el) == BaseID::PathInFile;
+                           });
+      if(it_p != it->subelements.end())
+        {
+          pathInFile(*it_p, fingerprint);
+        }
+    }
+
+  QByteArray hash = QCryptographicHash::hash(
+      QByteArray(fingerprint.c_str(), fingerprint.size()),
+      QCryptographicHash::Sha256);
+  result = hash.toHex().toStdString();
+
+  return result;
+}
+
+void
+CoverCache::pathInFile(const UDBElement &path, std::string &result)
+{
+  result += "\n" + path.content;
+  for(auto it = path.subelements.begin(); it != path.subelements.end(); it++)
+    {
+      BaseID::ID id = bid.getId(*it);
+      if(id == BaseID::FBDPath)
+        {
+          result += "\nfbd:" + it->content;
+        }
+      else if(id == BaseID::PathInFile)
+        {
+          pathInFile(*it, result);
+        }
+    }
+}
+
+QImage
+CoverCache::loadCover(const std::string &key)
+{
+  QImage result;
+  if(key.empty())
+    {
+      return result;
+    }
+
+  std::filesystem::path p = cache_dir / std::filesystem::path(key + ".png");
+  std::error_code ec;
+  if(!std::filesystem::exists(p, ec))
+    {
+      return result;
+    }
+
+  QFile f(p);
+  if(f.open(QIODeviceBase::ReadOnly))
+    {
+      result.load(&f, "PNG");
+      f.close();
+    }
+
+  if(!result.isNull())
+    {
+      // Modification time is used as last access time (see
+      // removeOldCovers()).
+      std::filesystem::last_write_time(
+          p, std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+  return result;
+}
+
+void
+CoverCache::saveCover(const std::string &key, const QImage &cover)
+{
+  if(key.empty() || cover.isNull())
+    {
+      return void();
+    }
+
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir, ec);
+  if(ec)
+    {
+      std::cout << "CoverCache::saveCover: \"" << ec.message() << "\""
+                << std::endl;
+      return void();
+    }
+
+  std::filesystem::path p = cache_dir / std::filesystem::path(key + ".png");
+  uintmax_t old_size = std::filesystem::file_size(p, ec);
+  if(ec)
+    {
+      old_size = 0;
+    }
+  std::u8string u8str = p.u8string();
+  QSaveFile f(QString::fromUtf8(std::string(u8str.begin(), u8str.end())));
+  if(!f.open(QIODeviceBase::WriteOnly))
+    {
+      std::cout << "CoverCache::saveCover: cannot open file "
+                << f.fileName().toStdString() << std::endl;
+      return void();
+    }
+  if(!cover.save(&f, "PNG") || !f.commit())
+    {
+      std::cout << "CoverCache::saveCover: cannot write file "
+                << f.fileName().toStdString() << std::endl;
+      return void();
+    }
+  uintmax_t new_size = std::filesystem::file_size(p, ec);
+  if(ec)
+    {
+      new_size = 0;
+    }
+
+  std::lock_guard<std::mutex> lglock(cache_mtx);
+  cache_size -= std::min(cache_size, old_size);
+  cache_size += new_size;
+  if(cache_size > size_limit)
+    {
+      removeOldCovers();
+    }
+}
+
+uintmax_t
+CoverCache::scanCovers(
+    std::vector<std::tuple<std::filesystem::path,
+                           std::filesystem::file_time_type, uintmax_t>> &covers)
+{
+  uintmax_t result = 0;
+  std::error_code ec;
+  for(std::filesystem::directory_iterator dir_it(cache_dir, ec);
+      !ec && dir_it != std::filesystem::directory_iterator();
+      dir_it.increment(ec))
+    {
+      std::error_code ec_l;
+      if(!dir_it->is_regular_file(ec_l))
+        {
+          continue;
+        }
+      uintmax_t fsz = dir_it->file_size(ec_l);
+      std::filesystem::file_time_type lwt = dir_it->last_write_time(ec_l);
+      if(ec_l)
+        {
+          continue;
+        }
+      covers.emplace_back(dir_it->path(), lwt, fsz);
+      result += fsz;
+    }
+
+  return result;
+}
+
+void
+CoverCache::removeOldCovers()
+{
+  // Directory is scanned only when running total exceeds limit. Total is
+  // refreshed here, so changes made by other processes are taken into account.
+  std::vector<std::tuple<std::filesystem::path,
+                         std::filesystem::file_time_type, uintmax_t>>
+      covers;
+  cache_size = scanCovers(covers);
+
+  if(cache_size <= size_limit)
+    {
+      return void();
+    }
+
+  // Least recently used covers are removed until cache takes 90% of limit,
+  // so that limit is not hit again by next saved cover.
+  std::sort(covers.begin(), covers.end(),
+            [](const std::tuple<std::filesystem::path,
+                                std::filesystem::file_time_type, uintmax_t> &a,
+               const std::tuple<std::filesystem::path,
+                                std::filesystem::file_time_type, uintmax_t> &b)
+              {
+                return std::get<1>(a) < std::get<1>(b);
+              });
+  uintmax_t target = size_limit - size_limit / 10;
+  std::error_code ec;
+  for(auto it = covers.begin(); it != covers.end() && cache_size > target;
+      it++)
+    {
+      if(std::filesystem::remove(std::get<0>(*it), ec))
+        {
+          cache_size -= std::get<2>(*it);
+        }
+    }
+}
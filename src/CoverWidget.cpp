@@ -21,6 +21,7 @@
 #include <QDir>
 #include <QFileDialog>
 #include <QGraphicsDropShadowEffect>
+#include <QGuiApplication>
 #include <QLabel>
 #include <QMenu>
 #include <QPainter>
@@ -82,12 +83,56 @@ CoverWidget::~CoverWidget()
 
 void
 CoverWidget::setCover(const UDBElement &cover_obj)
+{
+  setCoverImage(coverImage(cover_obj, pixelsPerMM()));
+}
+
+void
+CoverWidget::setCoverImage(const QImage &image)
 {
   clearCover();
+  original_image = image;
+  if(!original_image.isNull())
+    {
+      cover = original_image.scaled(current_size, Qt::KeepAspectRatio,
+                                    Qt::SmoothTransformation);
+      QAction *act = new QAction(tr("Save as..."));
+      connect(act, &QAction::triggered, this, &CoverWidget::saveImageDialog);
+      this->addAction(act);
+      act_list.push_back(act);
+    }
+}
+
+QSizeF
+CoverWidget::pixelsPerMM()
+{
+  QScreen *screen = nullptr;
+  QWindow *window = this->window()->windowHandle();
+  if(window != nullptr)
+    {
+      screen = window->screen();
+    }
+  if(screen == nullptr)
+    {
+      screen = QGuiApplication::primaryScreen();
+    }
+  QSize pixels = screen->size();
+  QSizeF mm = screen->physicalSize();
+
+  return QSizeF(static_cast<qreal>(pixels.width()) / mm.width(),
+                static_cast<qreal>(pixels.height()) / mm.height());
+}
+
+// Does not touch widget state, so can be called from worker threads.
+QImage
+CoverWidget::coverImage(const UDBElement &cover_obj,
+                        const QSizeF &pixels_per_mm)
+{
+  QImage result;
 
   if(cover_obj.content.empty())
     {
-      return void();
+      return result;
     }
 
   std::vector<UDBElement>::const_iterator it = std::find_if(
@@ -98,7 +143,7 @@ CoverWidget::setCover(const UDBElement &cover_obj)
         });
   if(it == cover_obj.subelements.end())
     {
-      return void();
+      return result;
     }
 
   if(it->content == "base64" || it->content == "image")
@@ -125,10 +170,10 @@ CoverWidget::setCover(const UDBElement &cover_obj)
         }
       catch(Magick::Exception &er)
         {
-          std::cout << "CoverWidget::setCover: \"" << er.what() << "\""
+          std::cout << "CoverWidget::coverImage: \"" << er.what() << "\""
                     << std::endl;
           delete[] buf;
-          return void();
+          return result;
         }
 
       if(need_byte_conversion)
@@ -151,7 +196,7 @@ CoverWidget::setCover(const UDBElement &cover_obj)
                 }
             }
         }
-      original_image = QImage(
+      result = QImage(
           buf, static_cast<int>(image.columns()),
           static_cast<int>(image.rows()), QImage::Format_RGBA8888,
           [](void *info)
@@ -163,18 +208,13 @@ CoverWidget::setCover(const UDBElement &cover_obj)
     }
   else if(it->content == "text" || it->content == "txt" || it->content == "md")
     {
-      QScreen *screen
-          = this->parentWidget()->window()->windowHandle()->screen();
-      QSize pixels = screen->size();
-      QSizeF mm = screen->physicalSize();
-      qreal h_pixels_per_mm = static_cast<qreal>(pixels.width()) / mm.width();
-      qreal v_pixels_per_mm
-          = static_cast<qreal>(pixels.height()) / mm.height();
+      qreal h_pixels_per_mm = pixels_per_mm.width();
+      qreal v_pixels_per_mm = pixels_per_mm.height();
       int w = static_cast<int>(210.0 * h_pixels_per_mm);
       int h = static_cast<int>(297.0 * v_pixels_per_mm);
       QSize a4_pixels(w, h);
-      original_image = QImage(a4_pixels, QImage::Format_ARGB32);
-      original_image.fill(Qt::white);
+      result = QImage(a4_pixels, QImage::Format_ARGB32);
+      result.fill(Qt::white);
 
       std::string txt = cover_obj.content;
       if(it->content == "text")
@@ -221,14 +261,14 @@ CoverWidget::setCover(const UDBElement &cover_obj)
         }
 
       QPainter painter;
-      if(painter.begin(&original_image))
+      if(painter.begin(&result))
         {
           doc.drawContents(&painter);
           painter.end();
         }
       else
         {
-          original_image = QImage();
+          result = QImage();
         }
     }
   else if(it->content == "ARGB" || it->content == "RGB")
@@ -281,7 +321,7 @@ CoverWidget::setCover(const UDBElement &cover_obj)
             }
           if(it->content == "ARGB")
             {
-              original_image = QImage(
+              result = QImage(
                   buf, w, h, QImage::Format_ARGB32,
                   [](void *info)
                     {
@@ -293,7 +333,7 @@ CoverWidget::setCover(const UDBElement &cover_obj)
             }
           else
             {
-              original_image = QImage(
+              result = QImage(
                   buf, w, h, QImage::Format_RGBX8888,
                   [](void *info)
                     {
@@ -305,15 +345,8 @@ CoverWidget::setCover(const UDBElement &cover_obj)
             }
         }
     }
-  if(!original_image.isNull())
-    {
-      cover = original_image.scaled(current_size, Qt::KeepAspectRatio,
-                                    Qt::SmoothTransformation);
-      QAction *act = new QAction(tr("Save as..."));
-      connect(act, &QAction::triggered, this, &CoverWidget::saveImageDialog);
-      this->addAction(act);
-      act_list.push_back(act);
-    }
+
+  return result;
 }
 
 void
@@ -329,6 +362,25 @@ CoverWidget::clearCover()
   this->update();
 }
 
+void
+CoverWidget::setFullCoverOnDemand(const bool &on_demand)
+{
+  full_cover_on_demand = on_demand;
+}
+
+void
+CoverWidget::showCoverWindow(const QImage &image)
+{
+  if(image.isNull() && original_image.isNull())
+    {
+      return void();
+    }
+  CoverWindow *win = new CoverWindow(
+      this->window(), image.isNull() ? original_image : image);
+  win->createWindow();
+  win->show();
+}
+
 void
 CoverWidget::paintEvent(QPaintEvent *event)
 {
@@ -368,9 +420,16 @@ CoverWidget::mousePressEvent(QMouseEvent *event)
 {
   if(event->button() == Qt::LeftButton && !original_image.isNull())
     {
-      CoverWindow *win = new CoverWindow(this->window(), original_image);
-      win->createWindow();
-      win->show();
+      // Shown cover can be rendered at widget size only. In this case owner
+      // renders cover again and calls showCoverWindow().
+      if(full_cover_on_demand)
+        {
+          emit signalFullCoverRequested();
+        }
+      else
+        {
+          showCoverWindow(original_image);
+        }
     }
   QWidget::mousePressEvent(event);
 }
@@ -79,6 +79,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 
   settings = std::make_shared<SettingsManager>();
 
+  p = std::u8string(str.begin(), str.end());
+  p /= std::u8string(u8".cache");
+  p /= std::u8string(u8"MyLibrary");
+  p /= std::u8string(u8"Covers");
+  cover_cache = std::make_shared<CoverCache>(p);
+
   plugins = std::make_shared<PluginManager>(bases);
 
   this->setObjectName("MainWindow");
@@ -240,7 +246,8 @@ MainWindow::createWindow()
   central_widget->insertWidget(1, left_widget);
 
   MainWindowRightWidget *right_widget
-      = new MainWindowRightWidget(central_widget, bases, settings);
+      = new MainWindowRightWidget(central_widget, bases, settings,
+                                  cover_cache);
   central_widget->insertWidget(2, right_widget);
 
   connect(this, &MainWindow::signalCollectionRemoved, left_widget,
@@ -44,11 +44,13 @@
 
 MainWindowRightWidget::MainWindowRightWidget(
     QWidget *parent, const Bases &bases,
-    const std::shared_ptr<SettingsManager> &settings)
+    const std::shared_ptr<SettingsManager> &settings,
+    const std::shared_ptr<CoverCache> &cover_cache)
     : QWidget(parent)
 {
   this->bases = bases;
   this->settings = settings;
+  this->cover_cache = cover_cache;
   book_info = new BookInfo(bases.mlbp);
   open_book = new OpenBook(bases.mlbp);
 
@@ -66,6 +68,11 @@ MainWindowRightWidget::MainWindowRightWidget(
 
 MainWindowRightWidget::~MainWindowRightWidget()
 {
+  info_mtx.lock();
+  info_request_id++;
+  pending_info.reset();
+  info_mtx.unlock();
+
   std::unique_lock<std::mutex> ullock(thr_num_mtx);
   thr_num_var.wait(ullock,
                    [this]
@@ -150,8 +157,7 @@ MainWindowRightWidget::setBookSearchResult(
   QScrollBar *v_bar = search_view->verticalScrollBar();
   v_bar->setValue(v_bar->minimum());
 
-  annotation->setText("");
-  cover->clearCover();
+  clearBookInfo();
 
   QList<QAction *> actions = operations->actions();
   for(qsizetype i = 0; i < actions.size(); i++)
@@ -212,12 +218,17 @@ MainWindowRightWidget::setBookSearchResult(
             }
         });
 
-  if(search_result_singleclicked)
+  if(search_result_current_changed)
     {
-      disconnect(search_result_singleclicked);
+      disconnect(search_result_current_changed);
     }
-  search_result_singleclicked = connect(search_view, &TableView::clicked, this,
-                                        &MainWindowRightWidget::getBookInfo);
+  search_result_current_changed
+      = connect(search_view->selectionModel(),
+                &QItemSelectionModel::currentRowChanged, this,
+                [this](const QModelIndex &current, const QModelIndex &)
+                  {
+                    getBookInfo(current);
+                  });
 
   search_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
 }
@@ -286,8 +297,7 @@ MainWindowRightWidget::setFilesSearchResult(
   QScrollBar *v_bar = search_view->verticalScrollBar();
   v_bar->setValue(v_bar->minimum());
 
-  annotation->setText("");
-  cover->clearCover();
+  clearBookInfo();
 
   QList<QAction *> actions = operations->actions();
   for(qsizetype i = 0; i < actions.size(); i++)
@@ -320,9 +330,9 @@ MainWindowRightWidget::setFilesSearchResult(
       disconnect(search_result_doubleclicked);
     }
 
-  if(search_result_singleclicked)
+  if(search_result_current_changed)
     {
-      disconnect(search_result_singleclicked);
+      disconnect(search_result_current_changed);
     }
 }
 
@@ -391,8 +401,7 @@ MainWindowRightWidget::setAuthorsSearchResult(
   QScrollBar *v_bar = search_view->verticalScrollBar();
   v_bar->setValue(v_bar->minimum());
 
-  annotation->setText("");
-  cover->clearCover();
+  clearBookInfo();
 
   QList<QAction *> actions = operations->actions();
   for(qsizetype i = 0; i < actions.size(); i++)
@@ -426,9 +435,9 @@ MainWindowRightWidget::setAuthorsSearchResult(
       disconnect(search_result_doubleclicked);
     }
 
-  if(search_result_singleclicked)
+  if(search_result_current_changed)
     {
-      disconnect(search_result_singleclicked);
+      disconnect(search_result_current_changed);
     }
 }
 
@@ -574,17 +583,41 @@ MainWindowRightWidget::createWidget()
   h_box->addWidget(annotation, 85);
 
   cover = new CoverWidget(nullptr, format_annotation);
+  cover->setFullCoverOnDemand(true);
   h_box->addWidget(cover, 15);
+  connect(cover, &CoverWidget::signalFullCoverRequested, this,
+          &MainWindowRightWidget::showFullCover);
 
   connect(this, &MainWindowRightWidget::signalShowBooks, this,
           &MainWindowRightWidget::setBookSearchResult);
 
+  connect(this, &MainWindowRightWidget::signalBookAnnotation, this,
+          [this](const uint64_t &request_id, const QString &text)
+            {
+              if(currentBookInfo(request_id))
+                {
+                  annotation->setHtml(text);
+                  annotation->setAlignment(Qt::AlignJustify);
+                }
+            });
+
+  connect(this, &MainWindowRightWidget::signalBookCover, this,
+          [this](const uint64_t &request_id, const QImage &image)
+            {
+              if(currentBookInfo(request_id))
+                {
+                  cover->setCoverImage(image);
+                  cover->update();
+                }
+            });
+
   connect(this, &MainWindowRightWidget::signalShowBooksWindow, this,
           [this](const UDBase &search_result, QWidget *spw,
                  const std::filesystem::path &collection_base_path)
             {
               MainWindowRightWidget *win
-                  = new MainWindowRightWidget(this->window(), bases, settings);
+                  = new MainWindowRightWidget(this->window(), bases, settings,
+                                              cover_cache);
               win->setWindowFlag(Qt::Window, true);
               win->setObjectName("Window");
               win->setAttribute(Qt::WA_DeleteOnClose);
@@ -825,6 +858,13 @@ MainWindowRightWidget::bookActions(const Qt::ItemFlags &editable)
                           index.constInternalPointer());
                   if(el != nullptr)
                     {
+                      QScreen *screen
+                          = this->window()->windowHandle()->screen();
+                      book_info->setDPI(
+                          static_cast<double>(screen->physicalDotsPerInchX()),
+                          static_cast<double>(screen->physicalDotsPerInchY()));
+                      QSize av_sz = screen->availableSize();
+                      book_info->setCoverSize(av_sz.width(), av_sz.height());
                       UDBase info;
                       try
                         {
@@ -1023,8 +1063,167 @@ MainWindowRightWidget::authorActions()
 void
 MainWindowRightWidget::getBookInfo(const QModelIndex &index)
 {
+  clearBookInfo();
+  if(!index.isValid())
+    {
+      return void();
+    }
+  const SearchViewModelItem *el
+      = reinterpret_cast<const SearchViewModelItem *>(
+          index.constInternalPointer());
+  if(el == nullptr)
+    {
+      return void();
+    }
+
+  BookInfoRequest request;
+  request.book_search_result = el->book_search_result;
+
+  QScreen *screen = this->window()->windowHandle()->screen();
+  request.horizontal_dpi = static_cast<double>(screen->physicalDotsPerInchX());
+  request.vertical_dpi = static_cast<double>(screen->physicalDotsPerInchY());
+  // Pages of pdf and djvu books are rendered to fit cover widget. Cover is
+  // rendered again at screen size if CoverWindow is opened (see
+  // showFullCover()).
+  request.cover_size = cover->size() * cover->devicePixelRatioF();
+  if(request.cover_size.isEmpty())
+    {
+      request.cover_size = screen->availableSize();
+    }
+  request.pixels_per_mm = cover->pixelsPerMM();
+
+  std::lock_guard<std::mutex> lglock(info_mtx);
+  request.id = info_request_id;
+  pending_info = request;
+  if(!info_worker_running)
+    {
+      info_worker_running = true;
+      std::lock_guard<std::mutex> lglock(thr_num_mtx);
+      thr_num++;
+      std::thread thr(
+          [this]
+            {
+              bookInfoWorker();
+            });
+      thr.detach();
+    }
+}
+
+void
+MainWindowRightWidget::clearBookInfo()
+{
+  info_mtx.lock();
+  info_request_id++;
+  pending_info.reset();
+  info_mtx.unlock();
+
   annotation->setText("");
   cover->clearCover();
+}
+
+bool
+MainWindowRightWidget::currentBookInfo(const uint64_t &request_id)
+{
+  std::lock_guard<std::mutex> lglock(info_mtx);
+  return request_id == info_request_id;
+}
+
+void
+MainWindowRightWidget::bookInfoWorker()
+{
+  BookInfo loader(bases.mlbp);
+  for(;;)
+    {
+      std::unique_lock<std::mutex> ullock(info_mtx);
+      if(!pending_info)
+        {
+          info_worker_running = false;
+          ullock.unlock();
+
+          std::lock_guard<std::mutex> lglock(thr_num_mtx);
+          thr_num--;
+          thr_num_var.notify_all();
+          return void();
+        }
+      BookInfoRequest request = std::move(*pending_info);
+      pending_info.reset();
+      ullock.unlock();
+
+      // Cached cover is shown before book is parsed. Pages of pdf and djvu
+      // books are not rendered in this case.
+      std::string cover_key
+          = cover_cache->coverKey(request.book_search_result);
+      QImage cached_cover = cover_cache->loadCover(cover_key);
+      if(!cached_cover.isNull())
+        {
+          emit signalBookCover(request.id, cached_cover);
+        }
+
+      loader.setDPI(request.horizontal_dpi, request.vertical_dpi);
+      loader.setCoverSize(request.cover_size.width(),
+                          request.cover_size.height());
+      loader.setCoverRendering(cached_cover.isNull());
+      UDBase info;
+      try
+        {
+          info = loader.getBookInfo(request.book_search_result);
+        }
+      catch(std::exception &er)
+        {
+          std::cout << "MainWindowRightWidget::bookInfoWorker: \""
+                    << er.what() << "\"" << std::endl;
+          continue;
+        }
+
+      // Selection could be changed while book was parsed. Results of stale
+      // requests are dropped, next pending request (if any) is taken instead.
+      std::vector<UDBElement> *raw_base = info.getRawBase();
+      for(auto it = raw_base->begin(); it != raw_base->end(); it++)
+        {
+          if(!currentBookInfo(request.id))
+            {
+              break;
+            }
+          if(bid.getId(*it) == BaseID::Annotation)
+            {
+              formatAnnotation(it->content);
+              emit signalBookAnnotation(
+                  request.id, QString::fromUtf8(it->content.c_str()));
+            }
+        }
+
+      if(!cached_cover.isNull())
+        {
+          continue;
+        }
+      for(auto it = raw_base->begin(); it != raw_base->end(); it++)
+        {
+          if(!currentBookInfo(request.id))
+            {
+              break;
+            }
+          if(bid.getId(*it) == BaseID::CoverPage)
+            {
+              QImage image = cover->coverImage(*it, request.pixels_per_mm);
+              emit signalBookCover(request.id, image);
+              // Covers stored in books as images can be bigger than widget.
+              if(request.cover_size.isValid()
+                 && (image.width() > request.cover_size.width()
+                     || image.height() > request.cover_size.height()))
+                {
+                  image = image.scaled(request.cover_size, Qt::KeepAspectRatio,
+                                       Qt::SmoothTransformation);
+                }
+              cover_cache->saveCover(cover_key, image);
+            }
+        }
+    }
+}
+
+void
+MainWindowRightWidget::showFullCover()
+{
+  QModelIndex index = search_view->currentIndex();
   if(!index.isValid())
     {
       return void();
@@ -1032,72 +1231,76 @@ MainWindowRightWidget::getBookInfo(const QModelIndex &index)
   const SearchViewModelItem *el
       = reinterpret_cast<const SearchViewModelItem *>(
           index.constInternalPointer());
+  if(el == nullptr)
+    {
+      return void();
+    }
 
   QScreen *screen = this->window()->windowHandle()->screen();
   book_info->setDPI(static_cast<double>(screen->physicalDotsPerInchX()),
                     static_cast<double>(screen->physicalDotsPerInchY()));
+  QSize av_sz = screen->availableSize();
+  book_info->setCoverSize(av_sz.width(), av_sz.height());
 
-  UDBase info;
+  QImage image;
   try
     {
-      info = book_info->getBookInfo(el->book_search_result);
+      UDBase info = book_info->getBookInfo(el->book_search_result);
+      std::vector<UDBElement> *raw_base = info.getRawBase();
+      for(auto it = raw_base->begin(); it != raw_base->end(); it++)
+        {
+          if(bid.getId(*it) == BaseID::CoverPage)
+            {
+              image = cover->coverImage(*it, cover->pixelsPerMM());
+              break;
+            }
+        }
     }
   catch(std::exception &er)
     {
-      std::cout << "MainWindowRightWidget::getBookInfo: \"" << er.what()
+      std::cout << "MainWindowRightWidget::showFullCover: \"" << er.what()
                 << "\"" << std::endl;
-      return void();
     }
 
-  std::vector<UDBElement> *raw_base = info.getRawBase();
+  // Cover shown in widget is used if book cannot be parsed.
+  cover->showCoverWindow(image);
+}
+
+void
+MainWindowRightWidget::formatAnnotation(std::string &annotation)
+{
   std::string::size_type n;
   std::string find_str("l:href");
   std::string find_str2("<br><br><br>");
   std::string ins_start("<annotation>");
   std::string ins_end("</annotation>");
-  for(auto it = raw_base->begin(); it != raw_base->end(); it++)
+
+  format_annotation->replaceTags(annotation);
+  annotation.insert(annotation.begin(), ins_start.begin(), ins_start.end());
+  std::copy(ins_end.begin(), ins_end.end(), std::back_inserter(annotation));
+  format_annotation->replaceTags(annotation);
+  format_annotation->removeEscapeSequences(annotation);
+  format_annotation->finalCleaning(annotation);
+  n = 0;
+  for(;;)
     {
-      if(bid.getId(*it) == BaseID::Annotation)
+      n = annotation.find(find_str, n);
+      if(n == std::string::npos)
         {
-          format_annotation->replaceTags(it->content);
-          it->content.insert(it->content.begin(), ins_start.begin(),
-                             ins_start.end());
-          std::copy(ins_end.begin(), ins_end.end(),
-                    std::back_inserter(it->content));
-          format_annotation->replaceTags(it->content);
-          format_annotation->removeEscapeSequences(it->content);
-          format_annotation->finalCleaning(it->content);
-          n = 0;
-          for(;;)
-            {
-              n = it->content.find(find_str, n);
-              if(n == std::string::npos)
-                {
-                  break;
-                }
-              it->content.erase(it->content.begin() + n,
-                                it->content.begin() + n + 2);
-            }
-          n = 0;
-          for(;;)
-            {
-              n = it->content.find(find_str2, n);
-              if(n == std::string::npos)
-                {
-                  break;
-                }
-              it->content.erase(it->content.begin() + n,
-                                it->content.begin() + n
-                                    + find_str2.size() / 3);
-            }
-          annotation->setHtml(it->content.c_str());
-          annotation->setAlignment(Qt::AlignJustify);
+          break;
         }
-      else if(bid.getId(*it) == BaseID::CoverPage)
+      annotation.erase(annotation.begin() + n, annotation.begin() + n + 2);
+    }
+  n = 0;
+  for(;;)
+    {
+      n = annotation.find(find_str2, n);
+      if(n == std::string::npos)
         {
-          cover->setCover(*it);
-          cover->update();
+          break;
         }
+      annotation.erase(annotation.begin() + n,
+                       annotation.begin() + n + find_str2.size() / 3);
     }
 }
 
@@ -1494,8 +1697,7 @@ MainWindowRightWidget::clearSearchResult()
   search_view->setModel(nullptr);
   delete model;
 
-  annotation->setText("");
-  cover->clearCover();
+  clearBookInfo();
   QList<QAction *> actions = operations->actions();
   for(qsizetype i = 0; i < actions.size(); i++)
     {